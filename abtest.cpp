@@ -0,0 +1,374 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <imgui.h>
+
+#include <easylogging++.h>
+
+#include "abtest.h"
+#include "addon.h"
+#include "frames.h"
+#include "sweep.h"
+
+// =========================
+// Override sets and run parameters
+// =========================
+struct override_set {
+    bool enabled = false;
+    std::array<bool, kItemCount> enables{};
+    std::array<Value, kItemCount> values{};
+};
+
+static override_set capture() { return {gEnabled, gEnables, gValues}; }
+static void restore(const override_set &set) {
+    gEnabled = set.enabled;
+    gEnables = set.enables;
+    gValues = set.values;
+    apply_overrides();
+}
+
+enum class ab_mode : int { single_item = 0, snapshots = 1 };
+
+static ab_mode gMode = ab_mode::single_item;
+static int gItem = 0;
+static std::array<override_set, 2> gSnapshots{};
+static std::array<bool, 2> gCaptured{};
+static int gFramesPerArm = 240;
+static int gWarmup = 60; // dropped at the start of every arm while the pipeline settles on the new settings
+static int gCycles = 10;
+
+// =========================
+// Run state
+// =========================
+struct segment {
+    int cycle;
+    int arm; // 0 = A, 1 = B
+    std::vector<frame_sample> frames;
+};
+
+struct arm_stats {
+    std::size_t frames = 0;
+    double mean = 0.0;
+    double p50 = 0.0;
+    double p95 = 0.0;
+    double p99 = 0.0;
+};
+
+struct ab_result {
+    std::array<arm_stats, 2> arms{};
+    std::size_t cycles = 0;  // cycles that produced samples for both arms
+    double delta = 0.0;      // mean B - mean A, ms
+    double half_width = NAN; // 95% confidence half width of delta, NAN with fewer than two cycles
+};
+
+static bool gRunning = false;
+static std::array<override_set, 2> gArms{};
+static std::array<std::string, 2> gArmLabels{};
+static override_set gSaved{};
+static int gCycle = 0;
+static int gSlot = 0; // position within the current cycle
+static uint64_t gArmStart = 0;
+static std::vector<segment> gSegments;
+static std::vector<frame_sample> gScratch;
+static ab_result gResult{};
+static bool gHaveResult = false;
+
+// counterbalanced order (AB, BA, AB, ...) so slow drift, e.g. shader caches warming up, doesn't favour one arm
+static int current_arm() { return (gSlot ^ gCycle) & 1; }
+
+static void enter_arm() {
+    restore(gArms[current_arm()]);
+    gArmStart = frame_count();
+}
+
+// =========================
+// Statistics
+// =========================
+// two-sided 95% Student t quantiles for 1..30 degrees of freedom, normal beyond
+static double t975(std::size_t dof) {
+    static constexpr std::array<double, 30> kTable = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228, 2.201, 2.179, 2.160, 2.145, 2.131,
+        2.120,  2.110, 2.101, 2.093, 2.086, 2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042};
+    return dof == 0 ? NAN : dof <= kTable.size() ? kTable[dof - 1] : 1.960;
+}
+
+static double segment_mean(const segment &seg) {
+    double total = 0.0;
+    for (const auto &frame : seg.frames)
+        total += frame.ms;
+    return seg.frames.empty() ? NAN : total / static_cast<double>(seg.frames.size());
+}
+
+static arm_stats stats_of(int arm) {
+    std::vector<float> ms;
+    double total = 0.0;
+    for (const auto &seg : gSegments) {
+        if (seg.arm != arm)
+            continue;
+        for (const auto &frame : seg.frames) {
+            ms.push_back(frame.ms);
+            total += frame.ms;
+        }
+    }
+    arm_stats stats;
+    stats.frames = ms.size();
+    if (ms.empty())
+        return stats;
+    stats.mean = total / static_cast<double>(ms.size());
+    stats.p50 = frame_percentile(ms, 0.50f);
+    stats.p95 = frame_percentile(ms, 0.95f);
+    stats.p99 = frame_percentile(ms, 0.99f);
+    return stats;
+}
+
+// Consecutive frames are strongly autocorrelated, so treating every frame as an independent sample would make the
+// interval far too narrow. Each cycle instead contributes one paired difference of its two segment means.
+static ab_result summarize() {
+    ab_result result;
+    result.arms = {stats_of(0), stats_of(1)};
+
+    std::vector<double> deltas;
+    for (int cycle = 0; cycle < gCycles; ++cycle) {
+        std::array<double, 2> means = {NAN, NAN};
+        for (const auto &seg : gSegments)
+            if (seg.cycle == cycle)
+                means[seg.arm] = segment_mean(seg);
+        if (!std::isnan(means[0]) && !std::isnan(means[1]))
+            deltas.push_back(means[1] - means[0]);
+    }
+
+    result.cycles = deltas.size();
+    if (deltas.empty())
+        return result;
+    double total = 0.0;
+    for (auto d : deltas)
+        total += d;
+    result.delta = total / static_cast<double>(deltas.size());
+    if (deltas.size() >= 2) {
+        double sq = 0.0;
+        for (auto d : deltas)
+            sq += (d - result.delta) * (d - result.delta);
+        const auto sd = std::sqrt(sq / static_cast<double>(deltas.size() - 1));
+        result.half_width = t975(deltas.size() - 1) * sd / std::sqrt(static_cast<double>(deltas.size()));
+    }
+    return result;
+}
+
+// =========================
+// Driving the run (render thread)
+// =========================
+static void start() {
+    if (gMode == ab_mode::single_item) {
+        const auto key = kItems[static_cast<std::size_t>(gItem)].key;
+        gArms[0] = capture();
+        gArms[0].enabled = true;
+        gArms[0].enables[static_cast<std::size_t>(gItem)] = true;
+        gArms[1] = gArms[0];
+        gArms[1].enables[static_cast<std::size_t>(gItem)] = false;
+        gArmLabels = {std::string(key) + " on", std::string(key) + " off"};
+    } else {
+        gArms = gSnapshots;
+        gArmLabels = {"snapshot A", "snapshot B"};
+    }
+    gSaved = capture();
+    gSegments.clear();
+    gCycle = 0;
+    gSlot = 0;
+    gHaveResult = false;
+    gRunning = true;
+    enter_arm();
+    LOG(INFO) << "A/B test started: " << gArmLabels[0] << " vs " << gArmLabels[1] << ", " << gFramesPerArm
+              << " frames per arm, " << gCycles << " cycles";
+}
+
+static void finish() {
+    gRunning = false;
+    restore(gSaved);
+    gResult = summarize();
+    gHaveResult = true;
+    LOG(INFO) << "A/B test finished: A " << gResult.arms[0].mean << " ms, B " << gResult.arms[1].mean
+              << " ms, B - A " << gResult.delta << " +/- " << gResult.half_width << " ms over " << gResult.cycles
+              << " cycles";
+}
+
+void step_ab_test() {
+    if (!gRunning)
+        return;
+    const auto end = gArmStart + static_cast<uint64_t>(gFramesPerArm);
+    if (frame_count() < end)
+        return;
+
+    const auto first = copy_frames(gArmStart + static_cast<uint64_t>(gWarmup), gScratch);
+    segment seg{gCycle, current_arm(), {}};
+    for (std::size_t i = 0; i < gScratch.size() && first + i < end; ++i)
+        seg.frames.push_back(gScratch[i]);
+    gSegments.push_back(std::move(seg));
+
+    if (++gSlot == 2) {
+        gSlot = 0;
+        ++gCycle;
+    }
+    if (gCycle == gCycles)
+        finish();
+    else
+        enter_arm();
+}
+
+bool ab_test_running() { return gRunning; }
+
+void cancel_ab_test() {
+    if (!gRunning)
+        return;
+    gRunning = false;
+    LOG(INFO) << "A/B test cancelled";
+}
+
+// =========================
+// CSV export: raw per-frame samples plus a long-format summary next to them
+// =========================
+static void export_csv() {
+    using namespace std::chrono;
+    const auto stamp = std::to_string(duration_cast<seconds>(system_clock::now().time_since_epoch()).count());
+    const auto dir = std::filesystem::current_path();
+    const auto frames_path = dir / ("untitled-ab-" + stamp + ".csv");
+    const auto summary_path = dir / ("untitled-ab-" + stamp + "-summary.csv");
+
+    std::ofstream frames(frames_path);
+    frames << "cycle,arm,end_ns,ms\n";
+    for (const auto &seg : gSegments)
+        for (const auto &frame : seg.frames)
+            frames << seg.cycle << ',' << (seg.arm ? 'B' : 'A') << ',' << frame.end_ns << ',' << frame.ms << '\n';
+
+    std::ofstream summary(summary_path);
+    summary << "metric,value\n";
+    summary << "A.label," << gArmLabels[0] << "\nB.label," << gArmLabels[1] << '\n';
+    summary << "frames_per_arm," << gFramesPerArm << "\nwarmup," << gWarmup << "\ncycles," << gResult.cycles << '\n';
+    for (int arm = 0; arm < 2; ++arm) {
+        const auto &stats = gResult.arms[arm];
+        const char *name = arm ? "B" : "A";
+        summary << name << ".frames," << stats.frames << '\n';
+        summary << name << ".mean_ms," << stats.mean << '\n';
+        summary << name << ".p50_ms," << stats.p50 << '\n';
+        summary << name << ".p95_ms," << stats.p95 << '\n';
+        summary << name << ".p99_ms," << stats.p99 << '\n';
+    }
+    summary << "delta_ms," << gResult.delta << '\n';
+    summary << "ci95_low_ms," << gResult.delta - gResult.half_width << '\n';
+    summary << "ci95_high_ms," << gResult.delta + gResult.half_width << '\n';
+
+    if (frames && summary)
+        LOG(INFO) << "A/B results written to " << frames_path.string() << " and " << summary_path.string();
+    else
+        LOG(ERROR) << "Failed to write A/B results to " << dir.string();
+}
+
+// =========================
+// Overlay panel
+// =========================
+static std::size_t count_enabled(const override_set &set) {
+    return static_cast<std::size_t>(std::count(set.enables.begin(), set.enables.end(), true));
+}
+
+void draw_ab_test() {
+    ImGui::BeginDisabled(gRunning);
+    auto mode = static_cast<int>(gMode);
+    ImGui::RadioButton("Single item", &mode, static_cast<int>(ab_mode::single_item));
+    ImGui::SameLine();
+    ImGui::RadioButton("Snapshots", &mode, static_cast<int>(ab_mode::snapshots));
+    gMode = static_cast<ab_mode>(mode);
+
+    if (gMode == ab_mode::single_item) {
+        if (ImGui::BeginCombo("Item", kItems[static_cast<std::size_t>(gItem)].key)) {
+            for (std::size_t i = 0; i < kItemCount; ++i)
+                if (ImGui::Selectable(kItems[i].key, static_cast<int>(i) == gItem))
+                    gItem = static_cast<int>(i);
+            ImGui::EndCombo();
+        }
+        if (ImGui::IsItemHovered(ImGuiHoveredFlags_AllowWhenDisabled))
+            ImGui::SetTooltip("A enables the item with its current value, B disables it; everything else stays as is");
+    } else {
+        for (int arm = 0; arm < 2; ++arm) {
+            ImGui::PushID(arm);
+            if (ImGui::Button(arm ? "Capture B" : "Capture A")) {
+                gSnapshots[arm] = capture();
+                gCaptured[arm] = true;
+            }
+            ImGui::SameLine();
+            if (gCaptured[arm])
+                ImGui::Text("%s, %zu items enabled", gSnapshots[arm].enabled ? "gate on" : "gate off",
+                            count_enabled(gSnapshots[arm]));
+            else
+                ImGui::TextDisabled("not captured");
+            ImGui::PopID();
+        }
+    }
+
+    ImGui::SliderInt("Frames per arm", &gFramesPerArm, 30, 2000);
+    ImGui::SliderInt("Warmup frames", &gWarmup, 0, gFramesPerArm - 1);
+    gWarmup = std::min(gWarmup, gFramesPerArm - 1);
+    ImGui::SliderInt("Cycles", &gCycles, 1, 50);
+    ImGui::EndDisabled();
+
+    if (gRunning) {
+        const auto done = static_cast<float>(gCycle * 2 + gSlot) / static_cast<float>(gCycles * 2);
+        ImGui::ProgressBar(done);
+        ImGui::Text("cycle %d/%d, running %s", gCycle + 1, gCycles, gArmLabels[current_arm()].c_str());
+        if (ImGui::Button("Stop")) {
+            cancel_ab_test();
+            restore(gSaved);
+        }
+        return;
+    }
+
+    const bool ready = gMode == ab_mode::single_item || (gCaptured[0] && gCaptured[1]);
+    ImGui::BeginDisabled(!ready || sweep_running());
+    if (ImGui::Button("Start"))
+        start();
+    ImGui::EndDisabled();
+
+    if (!gHaveResult)
+        return;
+    ImGui::Separator();
+    if (ImGui::BeginTable("##ab_result", 6, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+        ImGui::TableSetupColumn("Arm");
+        ImGui::TableSetupColumn("Frames");
+        ImGui::TableSetupColumn("Mean ms");
+        ImGui::TableSetupColumn("p50 ms");
+        ImGui::TableSetupColumn("p95 ms");
+        ImGui::TableSetupColumn("p99 ms");
+        ImGui::TableHeadersRow();
+        for (int arm = 0; arm < 2; ++arm) {
+            const auto &stats = gResult.arms[arm];
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::Text("%c: %s", arm ? 'B' : 'A', gArmLabels[arm].c_str());
+            ImGui::TableNextColumn();
+            ImGui::Text("%zu", stats.frames);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", stats.mean);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", stats.p50);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", stats.p95);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", stats.p99);
+        }
+        ImGui::EndTable();
+    }
+
+    const auto base = gResult.arms[0].mean;
+    const auto pct = base > 0.0 ? 100.0 * gResult.delta / base : 0.0;
+    if (std::isnan(gResult.half_width))
+        ImGui::Text("B - A: %+.3f ms (%+.1f%%), need at least 2 cycles for a confidence interval", gResult.delta, pct);
+    else
+        ImGui::Text("B - A: %+.3f ms (%+.1f%%), 95%% CI [%+.3f, %+.3f] over %zu cycles", gResult.delta, pct,
+                    gResult.delta - gResult.half_width, gResult.delta + gResult.half_width, gResult.cycles);
+    if (ImGui::Button("Export CSV"))
+        export_csv();
+}
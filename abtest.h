@@ -0,0 +1,12 @@
+#pragma once
+
+// Automated A/B runs: alternates two override sets (or one item on/off) every K frames for M cycles and compares the
+// frame-time distributions collected for each arm. Everything runs on the render thread.
+
+// advances a running test; called from reshade_present right after record_frame()
+void step_ab_test();
+bool ab_test_running();
+// stops without restoring the overrides captured at start
+void cancel_ab_test();
+
+void draw_ab_test();
@@ -1,614 +1,51 @@
 #include <array>
 #include <atomic>
+#include <bit>
+#include <cfloat>
 #include <charconv>
-#include <tuple>
+#include <cstddef>
+#include <cstring>
+#include <string_view>
 #include <type_traits>
-#include <utility>
+#include <vector>
 
 #include <imgui.h>
 #include <reshade.hpp>
 
 #include <easylogging++.h>
 
+#include "abtest.h"
 #include "addon.h"
+#include "census.h"
+#include "curves.h"
+#include "cvars.h"
+#include "delivery.h"
 #include "eternal.h"
 #include "fields.h"
+#include "frames.h"
+#include "governor.h"
 #include "hook.h"
+#include "journal.h"
+#include "layout.h"
+#include "mixer.h"
+#include "presets.h"
+#include "profiler.h"
+#include "reflect.h"
+#include "search.h"
+#include "streaming.h"
+#include "sweep.h"
+#include "tasks.h"
+#include "ticks.h"
+#include "view.h"
+#include "zones.h"
 
 INITIALIZE_EASYLOGGINGPP
 
 // =========================
 // Constants / config
 // =========================
-static constexpr const char *kSection = "untitled";
 static constexpr const char *kOverlay = "untitled"; // registered overlay window title
-static bool gEnabled = false;                       // runtime-loaded: [untitled] Enabled=0/1
-
-// =========================
-// Tiny compile-time string (structural NTTP) and utilities
-// =========================
-template <std::size_t N> struct ct_string {
-    char v[N]{};
-    constexpr ct_string() = default;
-    // constexpr ctor from literal
-    constexpr ct_string(const char (&s)[N]) {
-        for (std::size_t i = 0; i < N; ++i)
-            v[i] = s[i];
-    }
-    static consteval std::size_t size() { return N ? N - 1 : 0; }
-    constexpr const char *c_str() const { return v; }
-    // structural equality by member-wise comparison is implicit
-};
-
-// concat two ct_strings -> new ct_string
-template <ct_string A, ct_string B> consteval auto ct_concat() {
-    constexpr std::size_t NA = A.size();
-    constexpr std::size_t NB = B.size();
-    ct_string<NA + NB + 1> out{};
-    for (std::size_t i = 0; i < NA; ++i)
-        out.v[i] = A.v[i];
-    for (std::size_t j = 0; j < NB; ++j)
-        out.v[NA - 1 + j] = B.v[j];
-    out.v[NA + NB - 1] = '\0';
-    return out;
-}
-
-// suffix constants we need
-static constexpr auto Suffix_Enabled = ct_string{".Enabled"};
-static constexpr auto Suffix_Value = ct_string{".Value"};
-
-// =========================
-// Schema node tags (types only; no runtime storage)
-// =========================
-template <ct_string Title> struct Group {
-    static constexpr auto title = Title;
-};
-
-template <ct_string Key, ct_string Info, typename T> struct ItemFree {
-    using value_type = T;
-    static_assert(std::is_same_v<T, int> || std::is_same_v<T, float>);
-    static constexpr auto key = Key;
-    static constexpr auto info = Info;
-    static constexpr auto key_enabled = ct_concat<Key, Suffix_Enabled>();
-    static constexpr auto key_value = ct_concat<Key, Suffix_Value>();
-};
-
-template <ct_string Key, ct_string Info, typename T, T Min, T Max> struct ItemRanged : ItemFree<Key, Info, T> {
-    static constexpr T min = Min;
-    static constexpr T max = Max;
-};
-
-template <typename T>
-concept IsGroup = requires { T::title; };
-
-template <typename T>
-concept IsItem = requires { typename T::value_type; };
-
-template <typename T>
-concept IsRangedItem = IsItem<T> && requires {
-    T::min;
-    T::max;
-};
-
-// =========================
-// Compile-time utilities over the tuple of types
-// =========================
-template <typename... Ts, typename F, std::size_t... I>
-constexpr void for_each_type_impl(std::tuple<Ts...> *, F &&f, std::index_sequence<I...>) {
-    // Expand f.template operator()<T>()... at compile-time
-    (f.template operator()<std::tuple_element_t<I, std::tuple<Ts...>>>(), ...);
-}
-
-template <typename Tuple, typename F> constexpr void for_each_type(F &&f) {
-    constexpr std::size_t N = std::tuple_size_v<Tuple>;
-    for_each_type_impl(static_cast<Tuple *>(nullptr), std::forward<F>(f), std::make_index_sequence<N>{});
-}
-
-// Count by predicate at compile time
-template <typename Tuple, auto Pred> consteval std::size_t count_by() {
-    std::size_t n = 0;
-    for_each_type<Tuple>([&]<typename Node>() {
-        if constexpr (Pred.template operator()<Node>())
-            ++n;
-    });
-    return n;
-}
-template <typename Tuple> consteval std::size_t count_items() {
-    return count_by<Tuple, []<typename Node>() { return IsItem<Node>; }>();
-}
-template <typename Tuple> consteval std::size_t count_groups() {
-    return count_by<Tuple, []<typename Node>() { return IsGroup<Node>; }>();
-}
-
-// =========================
-// Gui schema (compile-time)
-// Generated from PPS_FIELDS (addon.h) and overrides_grouped.md; order matches groups then fields therein
-// =========================
-using Schema = std::tuple<
-    Group<"Auto Exposure">,
-    ItemRanged<"AutoExposureApplyPhysicalCameraExposure",
-               "Enables physical camera exposure using ShutterSpeed/ISO/Aperture.", int, 0, 1>,
-    ItemRanged<"AutoExposureBias",
-               "Logarithmic adjustment for the exposure. Only used if a tonemapper is specified. 0: no adjustment,\n"
-               "-1:2x darker, -2:4x darker, 1:2x brighter, 2:4x brighter, ...",
-               float, -15.0f, 15.0f>,
-    ItemFree<"AutoExposureBiasBackup",
-             "With the auto exposure changes, we are changing the AutoExposureBias inside the serialization code. We\n"
-             "are storing that value before conversion here as a backup. Hopefully it will not be needed, and removed\n"
-             "in the next engine revision.",
-             float>,
-    ItemFree<"AutoExposureCalibrationConstant", "", float>,
-    ItemRanged<
-        "AutoExposureHighPercent",
-        "The eye adaptation will adapt to a value extracted from the luminance histogram of the scene color. The "
-        "value\n"
-        "is defined as having x percent below this brightness. Higher values give bright spots on the screen more\n"
-        "priority but can lead to less stable results. Lower values give the medium and darker values more priority\n"
-        "but might cause burn out of bright spots. >0, <100, good values are in the range 80 .. 95",
-        float, 0.0f, 100.0f>,
-    ItemRanged<
-        "AutoExposureLowPercent",
-        "The eye adaptation will adapt to a value extracted from the luminance histogram of the scene color. The "
-        "value\n"
-        "is defined as having x percent below this brightness. Higher values give bright spots on the screen more\n"
-        "priority but can lead to less stable results. Lower values give the medium and darker values more priority\n"
-        "but might cause burn out of bright spots. >0, <100, good values are in the range 70 .. 80",
-        float, 0.0f, 100.0f>,
-    ItemRanged<
-        "AutoExposureMaxBrightness",
-        "Auto-Exposure maximum adaptation. Eye Adaptation is disabled if Min = Max. Auto-exposure is\n"
-        "implemented by choosing an exposure value for which the average luminance generates a pixel brightness\n"
-        "equal to the Constant Calibration value. The Min/Max are expressed in pixel luminance (cd/m2) or in\n"
-        "EV100 when using ExtendDefaultLuminanceRange (see project settings).",
-        float, -10.0f, 20.0f>,
-    ItemRanged<"AutoExposureMethod", "Luminance computation method (AEM_Histogram=0, AEM_Basic=1, AEM_Manual=2)", int,
-               0, 2>,
-    ItemRanged<
-        "AutoExposureMinBrightness",
-        "Auto-Exposure minimum adaptation. Eye Adaptation is disabled if Min = Max. Auto-exposure is\n"
-        "implemented by choosing an exposure value for which the average luminance generates a pixel brightness\n"
-        "equal to the Constant Calibration value. The Min/Max are expressed in pixel luminance (cd/m2) or in\n"
-        "EV100 when using ExtendDefaultLuminanceRange (see project settings).",
-        float, -10.0f, 20.0f>,
-    ItemRanged<"AutoExposureSpeedDown", "", float, 0.02f, 20.0f>,
-    ItemRanged<"AutoExposureSpeedUp", "", float, 0.02f, 20.0f>,
-    ItemRanged<"HistogramLogMax",
-               "Histogram Max value. Expressed in Log2(Luminance) or in EV100 when using ExtendDefaultLuminanceRange",
-               float, 0.0f, 16.0f>,
-    ItemRanged<"HistogramLogMin",
-               "Histogram Min value. Expressed in Log2(Luminance) or in EV100 when using ExtendDefaultLuminanceRange",
-               float, -16.0f, 0.0f>,
-
-    Group<"Bloom">,
-    ItemRanged<
-        "Bloom1Size",
-        "Diameter size for the Bloom1 in percent of the screen width (is done in 1/2 resolution, larger values cost\n"
-        "more performance, good for high frequency details) >=0: can be clamped because of shader limitations",
-        float, 0.0f, 4.0f>,
-    ItemRanged<
-        "Bloom2Size",
-        "Diameter size for Bloom2 in percent of the screen width (is done in 1/4 resolution, larger values cost\n"
-        "more performance) >=0: can be clamped because of shader limitations",
-        float, 0.0f, 8.0f>,
-    ItemRanged<
-        "Bloom3Size",
-        "Diameter size for Bloom3 in percent of the screen width (is done in 1/8 resolution, larger values cost\n"
-        "more performance) >=0: can be clamped because of shader limitations",
-        float, 0.0f, 16.0f>,
-    ItemRanged<"Bloom4Size",
-               "Diameter size for Bloom4 in percent of the screen width (is done in 1/16 resolution, larger values\n"
-               "cost more performance, best for wide contributions) >=0: can be clamped because of shader limitations",
-               float, 0.0f, 32.0f>,
-    ItemRanged<"Bloom5Size",
-               "Diameter size for Bloom5 in percent of the screen width (is done in 1/32 resolution, larger values\n"
-               "cost more performance, best for wide contributions) >=0: can be clamped because of shader limitations",
-               float, 0.0f, 64.0f>,
-    ItemRanged<"Bloom6Size",
-               "Diameter size for Bloom6 in percent of the screen width (is done in 1/64 resolution, larger values\n"
-               "cost more performance, best for wide contributions) >=0: can be clamped because of shader limitations",
-               float, 0.0f, 128.0f>,
-    ItemRanged<"BloomConvolutionBufferScale",
-               "Implicit buffer region as a fraction of the screen size to insure the bloom does not wrap across the\n"
-               "screen. Larger sizes have perf impact.",
-               float, 0.0f, 1.0f>,
-    ItemFree<"BloomConvolutionPreFilterMax",
-             "Boost intensity of select pixels prior to computing bloom convolution (Min, Max, Multiplier). Max < Min\n"
-             "disables",
-             float>,
-    ItemFree<"BloomConvolutionPreFilterMin",
-             "Boost intensity of select pixels prior to computing bloom convolution (Min, Max, Multiplier). Max < Min\n"
-             "disables",
-             float>,
-    ItemFree<"BloomConvolutionPreFilterMult",
-             "Boost intensity of select pixels prior to computing bloom convolution (Min, Max, Multiplier). Max < Min\n"
-             "disables",
-             float>,
-    ItemRanged<"BloomConvolutionScatterDispersion",
-               "Intensity multiplier on the scatter dispersion energy of the kernel. 1.0 means exactly use the same\n"
-               "energy as the kernel scatter dispersion.",
-               float, 0.0f, 20.0f>,
-    ItemRanged<"BloomConvolutionSize",
-               "Relative size of the convolution kernel image compared to the minor axis of the viewport", float, 0.0f,
-               1.0f>,
-    ItemRanged<"BloomDirtMaskIntensity", "BloomDirtMask intensity", float, 0.0f, 8.0f>,
-    ItemRanged<"BloomIntensity", "Multiplier for all bloom contributions >=0: off, 1(default), >1 brighter", float,
-               0.0f, 8.0f>,
-    ItemRanged<"BloomMethod", "Bloom algorithm (BM_SOG=0, BM_FFT=1)", int, 0, 1>,
-    ItemRanged<"BloomSizeScale", "Scale for all bloom sizes", float, 0.0f, 64.0f>,
-    ItemRanged<
-        "BloomThreshold",
-        "minimum brightness the bloom starts having effect -1:all pixels affect bloom equally (physically correct,\n"
-        "faster as a threshold pass is omitted), 0:all pixels affect bloom brights more, 1(default), >1 brighter",
-        float, -1.0f, 8.0f>,
-
-    Group<"Camera & White Balance">, ItemFree<"CameraISO", "The camera sensor sensitivity in ISO.", float>,
-    ItemRanged<"CameraShutterSpeed", "The camera shutter in seconds.", float, 1.0f, 2000.0f>,
-    ItemRanged<"TemperatureType",
-               "Selects the type of temperature calculation. White Balance uses the Temperature value to control the\n"
-               "virtual camera's White Balance. This is the default selection. Color Temperature uses the Temperature\n"
-               "value to adjust the color temperature of the scene, which is the inverse of the White Balance\n"
-               "operation. (TEMP_WhiteBalance=0, TEMP_ColorTemperature=1)",
-               int, 0, 1>,
-    ItemRanged<"WhiteTemp", "Controls the color temperature (Kelvin) considered as white", float, 1500.0f, 15000.0f>,
-    ItemRanged<"WhiteTint", "Magenta-Green axis tint (orthogonal to temperature)", float, -1.0f, 1.0f>,
-
-    Group<"Chromatic Aberration">,
-    ItemRanged<"ChromaticAberrationStartOffset",
-               "A normalized distance to the center of the framebuffer where the effect takes place.", float, 0.0f,
-               1.0f>,
-    ItemRanged<"SceneFringeIntensity",
-               "in percent, Scene chromatic aberration / color fringe (camera imperfection) to simulate an artifact\n"
-               "that happens in real-world lens, mostly visible in the image corners.",
-               float, 0.0f, 5.0f>,
-
-    Group<"Color Grading & Tone Mapping">,
-    ItemRanged<"BlueCorrection",
-               "Correct for artifacts with \"electric\" blues due to the ACEScg color space. Bright blue desaturates\n"
-               "instead of going to violet.",
-               float, 0.0f, 1.0f>,
-    ItemRanged<"ColorCorrectionHighlightsMax",
-               "This value sets the upper threshold for what is considered to be the highlight region of the image.\n"
-               "This value should be larger than HighlightsMin. Default is 1.0, for backwards compatibility",
-               float, 1.0f, 10.0f>,
-    ItemRanged<"ColorCorrectionHighlightsMin",
-               "This value sets the lower threshold for what is considered to be the highlight region of the image.",
-               float, -1.0f, 1.0f>,
-    ItemRanged<"ColorCorrectionShadowsMax",
-               "This value sets the threshold for what is considered to be the shadow region of the image.", float,
-               -1.0f, 1.0f>,
-    ItemRanged<"ColorGradingIntensity", "Color grading lookup table intensity. 0 = no intensity, 1=full intensity",
-               float, 0.0f, 1.0f>,
-    ItemRanged<"ExpandGamut", "Expand bright saturated colors outside the sRGB gamut to fake wide gamut rendering.",
-               float, 0.0f, 1.0f>,
-    ItemRanged<"FilmBlackClip",
-               "Lowers the toe of the tonemapper curve by this amount. Increasing this value causes more of the scene\n"
-               "to clip to black. For most purposes, this property should remain 0",
-               float, 0.0f, 1.0f>,
-    ItemRanged<"FilmGrainHighlightsMax",
-               "Sets the upper bound used for Film Grain Highlight Intensity. This value should be larger than\n"
-               "HighlightsMin.. Default is 1.0, for backwards compatibility",
-               float, 1.0f, 10.0f>,
-    ItemRanged<"FilmGrainHighlightsMin", "Sets the lower bound used for Film Grain Highlight Intensity.", float, 0.0f,
-               1.0f>,
-    ItemRanged<"FilmGrainIntensity",
-               "0..1 Film grain intensity to apply. LinearSceneColor *= lerp(1.0, DecodedFilmGrainTexture,\n"
-               "FilmGrainIntensity)",
-               float, 0.0f, 1.0f>,
-    ItemRanged<"FilmGrainIntensityHighlights",
-               "Control over the grain intensity in the regions of the image considered highlight areas.", float, 0.0f,
-               1.0f>,
-    ItemRanged<"FilmGrainIntensityMidtones", "Control over the grain intensity in the mid-tone region of the image.",
-               float, 0.0f, 1.0f>,
-    ItemRanged<"FilmGrainIntensityShadows",
-               "Control over the grain intensity in the regions of the image considered shadow areas.", float, 0.0f,
-               1.0f>,
-    ItemRanged<"FilmGrainShadowsMax", "Sets the upper bound used for Film Grain Shadow Intensity.", float, 0.0f, 1.0f>,
-    ItemRanged<"FilmGrainTexelSize",
-               "Controls the size of the film grain. Size of texel of FilmGrainTexture on screen.", float, 0.0f, 4.0f>,
-    ItemRanged<"FilmShoulder",
-               "Sometimes referred to as highlight rolloff. Controls the contrast of the bright end of the tonemapper\n"
-               "curve. Larger values increase contrast and smaller values decrease contrast.",
-               float, 0.0f, 1.0f>,
-    ItemRanged<"FilmSlope",
-               "Controls the overall steepness of the tonemapper curve. Larger values increase scene contrast and\n"
-               "smaller values reduce contrast.",
-               float, 0.0f, 1.0f>,
-    ItemRanged<"FilmToe",
-               "Controls the contrast of the dark end of the tonemapper curve. Larger values increase contrast and\n"
-               "smaller values decrease contrast.",
-               float, 0.0f, 1.0f>,
-    ItemRanged<"FilmWhiteClip",
-               "Controls the height of the tonemapper curve. Raising this value can cause bright values to more\n"
-               "quickly approach fully-saturated white.",
-               float, 0.0f, 1.0f>,
-    ItemRanged<"Sharpen", "Controls the strength of image sharpening applied during tonemapping.", float, 0.0f, 10.0f>,
-    ItemRanged<"ToneCurveAmount",
-               "Allow effect of Tone Curve to be reduced (Set ToneCurveAmount and ExpandGamut to 0.0 to fully disable\n"
-               "tone curve)",
-               float, 0.0f, 1.0f>,
-
-    Group<"Fog">, ItemFree<"GbxFogDensityMultiplier", "", float>,
-
-    Group<"Global Illumination">,
-    ItemRanged<
-        "DynamicGlobalIlluminationMethod",
-        "Chooses the Dynamic Global Illumination method. Not compatible with Forward Shading. (None=0, Lumen=1,\n"
-        "ScreenSpace=2, Plugin=3)",
-        int, 0, 3>,
-    ItemRanged<"IndirectLightingIntensity",
-               "Scales the indirect lighting contribution. A value of 0 disables GI. Default is 1. The show flag\n"
-               "'Global Illumination' must be enabled to use this property.",
-               float, 0.0f, 4.0f>,
-
-    Group<"Lens Flare">,
-    ItemRanged<"LensFlareBokehSize",
-               "Size of the Lens Blur (in percent of the view width) that is done with the Bokeh texture (note:\n"
-               "performance cost is radius*radius)",
-               float, 0.0f, 32.0f>,
-    ItemRanged<"LensFlareIntensity", "Brightness scale of the image cased lens flares (linear)", float, 0.0f, 16.0f>,
-    ItemRanged<"LensFlareThreshold",
-               "Minimum brightness the lens flare starts having effect (this should be as high as possible to avoid\n"
-               "the performance cost of blurring content that is too dark too see)",
-               float, 0.1f, 32.0f>,
-
-    Group<"Local Exposure">,
-    ItemRanged<"LocalExposureBlurredLuminanceBlend",
-               "Local Exposure decomposes luminance of the frame into a base layer and a detail layer. Blend between\n"
-               "bilateral filtered and blurred luminance as the base layer. Blurred luminance helps preserve image "
-               "appearance\n"
-               "and specular highlights, and reduce ringing. Good values are usually in the range 0.4 .. 0.6",
-               float, 0.0f, 1.0f>,
-    ItemRanged<"LocalExposureBlurredLuminanceKernelSizePercent",
-               "Kernel size (percentage of screen) used to blur frame luminance.", float, 0.0f, 100.0f>,
-    ItemFree<"LocalExposureContrastScale", "", float>,
-    ItemRanged<
-        "LocalExposureDetailStrength",
-        "Local Exposure decomposes luminance of the frame into a base layer and a detail layer. Value different\n"
-        "than 1 will enable local exposure. This value should be set to 1 in most cases.",
-        float, 0.0f, 4.0f>,
-    ItemRanged<
-        "LocalExposureHighlightContrastScale",
-        "Local Exposure decomposes luminance of the frame into a base layer and a detail layer. Contrast of the\n"
-        "base layer is reduced based on this value. Value less than 1 will enable local exposure. Good values\n"
-        "are usually in the range 0.6 .. 1.0.",
-        float, 0.0f, 1.0f>,
-    ItemRanged<"LocalExposureHighlightThreshold",
-               "Threshold used to determine which regions of the screen are considered highlights.", float, 0.0f, 4.0f>,
-    ItemRanged<"LocalExposureMethod", "Local Exposure algorithm (Bilateral=0, Fusion=1)", int, 0, 1>,
-    ItemRanged<"LocalExposureMiddleGreyBias",
-               "Logarithmic adjustment for the local exposure middle grey. 0: no adjustment, -1:2x darker, -2:4x\n"
-               "darker, 1:2x brighter, 2:4x brighter, ...",
-               float, -15.0f, 15.0f>,
-    ItemRanged<
-        "LocalExposureShadowContrastScale",
-        "Local Exposure decomposes luminance of the frame into a base layer and a detail layer. Contrast of the\n"
-        "base layer is reduced based on this value. Value less than 1 will enable local exposure. Good values\n"
-        "are usually in the range 0.6 .. 1.0.",
-        float, 0.0f, 1.0f>,
-    ItemRanged<"LocalExposureShadowThreshold",
-               "Threshold used to determine which regions of the screen are considered shadows.", float, 0.0f, 4.0f>,
-
-    Group<"Lumen">,
-    ItemRanged<"LumenFinalGatherLightingUpdateSpeed",
-               "Controls how much Lumen Final Gather is allowed to cache lighting results to improve performance.\n"
-               "Larger scales cause lighting changes to propagate faster, but increase GPU cost and noise.",
-               float, 0.5f, 4.0f>,
-    ItemRanged<"LumenFinalGatherQuality",
-               "Scales Lumen's Final Gather quality. Larger scales reduce noise, but greatly increase GPU cost.", float,
-               0.25f, 2.0f>,
-    ItemRanged<"LumenFinalGatherScreenTraces",
-               "Whether to use screen space traces for Lumen Global Illumination. Screen space traces bypass Lumen\n"
-               "Scene and instead sample Scene Depth and Scene Color. This improves quality, as it bypasses Lumen\n"
-               "Scene, but causes view dependent lighting.",
-               int, 0, 1>,
-    ItemRanged<"LumenFrontLayerTranslucencyReflections",
-               "Whether to use high quality mirror reflections on the front layer of translucent surfaces. Other\n"
-               "layers will use the lower quality Radiance Cache method that can only produce glossy reflections.\n"
-               "Increases GPU cost when enabled.",
-               int, 0, 1>,
-    ItemRanged<
-        "LumenFullSkylightLeakingDistance",
-        "Controls the distance from a receiving surface where skylight leaking reaches its full intensity. Smaller\n"
-        "values make the skylight leaking flatter, while larger values create an Ambient Occlusion effect.",
-        float, 0.1f, 2000.0f>,
-    ItemRanged<
-        "LumenMaxReflectionBounces",
-        "Sets the maximum number of recursive reflection bounces. 1 means a single reflection ray (no secondary\n"
-        "reflections in mirrors). Currently only supported by Hardware Ray Tracing with Hit Lighting.",
-        int, 1, 8>,
-    ItemRanged<"LumenMaxRefractionBounces",
-               "The maximum count of refraction event to trace. When hit lighting is used, Translucent meshes will be\n"
-               "traced when LumenMaxRefractionBounces > 0, making the reflection tracing more expenssive.",
-               int, 0, 64>,
-    ItemRanged<
-        "LumenMaxRoughnessToTraceReflections",
-        "Sets the maximum roughness value for which Lumen still traces dedicated reflection rays. Higher values\n"
-        "improve reflection quality, but greatly increase GPU cost.",
-        float, 0.0f, 1.0f>,
-    ItemRanged<
-        "LumenMaxTraceDistance",
-        "Controls the maximum distance that Lumen should trace while solving lighting. Values that are too small will\n"
-        "cause lighting to leak into large caves, while values that are large will increase GPU cost.",
-        float, 1.0f, 2097152.0f>,
-    ItemRanged<"LumenRayLightingMode",
-               "Controls how Lumen rays are lit when Lumen is using Hardware Ray Tracing. By default, Lumen uses the\n"
-               "Surface Cache for best performance, but can be set to 'Hit Lighting' for higher quality. (Default=0,\n"
-               "SurfaceCache=1, HitLightingForReflections=2, HitLighting=3)",
-               int, 0, 3>,
-    ItemRanged<"LumenReflectionQuality",
-               "Scales the Reflection quality. Larger scales reduce noise in reflections, but increase GPU cost.",
-               float, 0.25f, 2.0f>,
-    ItemRanged<"LumenReflectionsScreenTraces",
-               "Whether to use screen space traces for Lumen Reflections. Screen space traces bypass Lumen Scene and\n"
-               "instead sample Scene Depth and Scene Color. This improves quality, as it bypasses Lumen Scene, but\n"
-               "causes view dependent lighting.",
-               int, 0, 1>,
-    ItemRanged<
-        "LumenSceneDetail",
-        "Controls the size of instances that can be represented in Lumen Scene. Larger values will ensure small\n"
-        "objects are represented, but increase GPU cost.",
-        float, 0.25f, 4.0f>,
-    ItemRanged<
-        "LumenSceneLightingQuality",
-        "Scales Lumen Scene's quality. Larger scales cause Lumen Scene to be calculated with a higher fidelity,\n"
-        "which can be visible in reflections, but increase GPU cost.",
-        float, 0.25f, 2.0f>,
-    ItemRanged<"LumenSceneLightingUpdateSpeed",
-               "Controls how much Lumen Scene is allowed to cache lighting results to improve performance. Larger\n"
-               "scales cause lighting changes to propagate faster, but increase GPU cost.",
-               float, 0.5f, 4.0f>,
-    ItemRanged<
-        "LumenSceneViewDistance",
-        "Sets the maximum view distance of the scene that Lumen maintains for ray tracing against. Larger values will\n"
-        "increase the effective range of sky shadowing and Global Illumination, but increase GPU cost.",
-        float, 1.0f, 2097152.0f>,
-    ItemRanged<"LumenSkylightLeaking",
-               "Controls what fraction of the skylight intensity should be allowed to leak. This can be useful as an\n"
-               "art direction knob (non-physically based) to keep indoor areas from going fully black.",
-               float, 0.0f, 0.02f>,
-    ItemRanged<
-        "LumenSurfaceCacheResolution",
-        "Scale factor for Lumen Surface Cache resolution, for Scene Capture. Smaller values save GPU memory, at\n"
-        "a cost in quality. Defaults to 0.5 if not overridden.",
-        float, 0.5f, 1.0f>,
-
-    Group<"MegaLights">,
-    ItemRanged<
-        "bMegaLights",
-        "Allows forcing MegaLights on or off for this volume, regardless of the project setting for MegaLights.\n"
-        "MegaLights will stochastically sample lights, which allows many shadow casting lights to be rendered\n"
-        "efficiently, with a consistent and low GPU cost. When MegaLights is enabled, other direct lighting\n"
-        "algorithms like Deferred Shading will no longer be used, and other shadowing methods like Ray Traced\n"
-        "Shadows, Distance Field Shadows and Shadow Maps will no longer be used. MegaLights requires Hardware\n"
-        "Ray Tracing and Shader Model 6.",
-        int, 0, 1>,
-
-    Group<"Motion Blur">, ItemRanged<"MotionBlurAmount", "Strength of motion blur, 0:off", float, 0.0f, 1.0f>,
-    ItemRanged<"MotionBlurDisableCameraInfluence", "", int, 0, 1>,
-    ItemRanged<"MotionBlurMax", "max distortion caused by motion blur, in percent of the screen width, 0:off", float,
-               0.0f, 100.0f>,
-    ItemRanged<"MotionBlurPerObjectSize",
-               "The minimum projected screen radius for a primitive to be drawn in the velocity pass, percentage of\n"
-               "screen width. smaller numbers cause more draw calls, default: 4%",
-               float, 0.0f, 100.0f>,
-    ItemRanged<
-        "MotionBlurTargetFPS",
-        "Defines the target FPS for motion blur. Makes motion blur independent of actual frame rate and\n"
-        "relative to the specified target FPS instead. Higher target FPS results in shorter frames, which means\n"
-        "shorter shutter times and less motion blur. Lower FPS means more motion blur. A value of zero makes\n"
-        "the motion blur dependent on the actual frame rate.",
-        int, 0, 120>,
-
-    Group<"Reflections">,
-    ItemRanged<"ReflectionMethod",
-               "Chooses the Reflection method. Not compatible with Forward Shading. (None=0, Lumen=1, ScreenSpace=2)",
-               int, 0, 2>,
-    ItemRanged<"ScreenSpaceReflectionIntensity",
-               "Enable/Fade/disable the Screen Space Reflection feature, in percent, avoid numbers between 0 and 1 fo\n"
-               "consistency",
-               float, 0.0f, 100.0f>,
-    ItemRanged<"ScreenSpaceReflectionMaxRoughness",
-               "Until what roughness we fade the screen space reflections, 0.8 works well, smaller can run faster",
-               float, 0.01f, 1.0f>,
-    ItemRanged<"ScreenSpaceReflectionQuality",
-               "0=lowest quality..100=maximum quality, only a few quality levels are implemented, no soft transition,\n"
-               "50 is the default for better performance.",
-               float, 0.0f, 100.0f>,
-
-    Group<"Vignette">, ItemRanged<"VignetteIntensity", "0..1 0=off .. 1=strong vignette", float, 0.0f, 1.0f>,
-
-    // ===== GBX PostProcess Settings ===== FIXME
-    // Group<"GbxEdgeDetection2">, ItemRanged<"EdgeDetectionType", "", int, 0, 1>,
-    // ItemFree<"EdgeDetection2StartFade", "", float>, ItemFree<"EdgeDetection2FadeDistance", "", float>,
-    // ItemFree<"EdgeDetection2SobelThickness", "", float>, ItemFree<"EdgeDetection2SobelThicknessOffset", "", float>,
-    // ItemFree<"EdgeDetection2SobelThinessOffset", "", float>, ItemFree<"EdgeDetection2FarDistance", "", float>,
-    // ItemFree<"EdgeDetection2DarkThreshold", "", float>, ItemFree<"EdgeDetection2HighlightThreshold", "", float>,
-    // ItemFree<"EdgeDetection2SobelDarkEdgeFadePower", "", float>,
-    // ItemFree<"EdgeDetection2GlobalInkChannelStrength", "", float>,
-    // ItemFree<"EdgeDetection2ThresholdRampStartDistance", "", float>,
-    // ItemFree<"EdgeDetection2ThresholdRampTransitionDistance", "", float>,
-    // ItemFree<"EdgeDetection2SobelHighlightEdgeFadePower", "", float>,
-    // ItemFree<"EdgeDetection2EvCurveExponent", "", float>, ItemFree<"EdgeDetection2EdgeHighlightThreshLow", "",
-    // float>, ItemFree<"EdgeDetection2EdgeHighlightThreshHigh", "", float>,
-    // ItemFree<"EdgeDetection2EdgeHighlightMaskExponent", "", float>,
-    // ItemFree<"EdgeDetection2HighlightThreshLow", "", float>, ItemFree<"EdgeDetection2HighlightThreshHigh", "",
-    // float>, ItemFree<"EdgeDetection2HighlightMaskExponent", "", float>, ItemFree<"EdgeDetection2HotspotThreshLow",
-    // "", float>, ItemFree<"EdgeDetection2HotspotThreshHigh", "", float>, ItemFree<"EdgeDetection2HotspotMaskExponent",
-    // "", float>, ItemFree<"EdgeDetection2EdgeHighlightDiffuseFactor", "", float>,
-    // ItemFree<"EdgeDetection2EdgeHighlightSourceIntensityLow", "", float>,
-    // ItemFree<"EdgeDetection2EdgeHighlightSourceIntensityHigh", "", float>,
-    // ItemFree<"EdgeDetection2EdgeHighlightSupersaturation", "", float>,
-    // ItemFree<"EdgeDetection2HighlightDiffuseFactor", "", float>,
-    // ItemFree<"EdgeDetection2HighlightSourceIntensity", "", float>,
-    // ItemFree<"EdgeDetection2HotspotDiffuseFactor", "", float>,
-    // ItemFree<"EdgeDetection2HotspotsSourceIntensity", "", float>,
-    // ItemFree<"EdgeDetection2EdgeHighlightChannelStrength", "", float>,
-    // ItemFree<"EdgeDetection2HotspotChannelStrength", "", float>, ItemFree<"EdgeDetection2HighlightDesat", "", float>,
-    // ItemFree<"EdgeDetection2HighlightHueShift", "", float>, ItemFree<"EdgeDetection2ExteriorDepthCutoff", "", float>,
-    // ItemFree<"EdgeDetection2HighlightChannelStrength", "", float>, ItemFree<"EdgeDetection2VisualizeInks", "",
-    // float>,
-
-    Group<"GbxEdgeDetection">, ItemRanged<"EdgeDetectionEnable", "", int, 0, 1>,
-    ItemFree<"EdgeDetectionHFilterAxisCoeff", "", float>, ItemFree<"EdgeDetectionHFilterDiagCoeff", "", float>,
-    ItemFree<"EdgeDetectionVFilterAxisCoeff", "", float>, ItemFree<"EdgeDetectionVFilterDiagCoeff", "", float>,
-    ItemFree<"EdgeDetectionFarDistance", "", float>, ItemFree<"EdgeDetectionNearDistance", "", float>,
-    ItemFree<"EdgeDetectionSobelPower", "", float>, ItemFree<"EdgeDetectionTexelOffset", "", float>,
-    ItemFree<"EdgeDetectionTransitionDistance", "", float>, ItemFree<"EdgeDetectionTransitionDistanceFar", "", float>,
-    ItemFree<"EdgeDetectionApplyThreshold", "", float>, ItemFree<"EdgeDerivativeCheckLimit", "", float>,
-    ItemFree<"EdgeDerivativeDeltaThreshold", "", float>>;
-
-static constexpr std::size_t kItemCount = count_items<Schema>();
-static constexpr std::size_t kGroupCount = count_groups<Schema>();
-
-// Compile-time duplicate key check
-template <typename Tuple> consteval bool check_unique_keys() {
-    // Gather keys into a constexpr array of string views
-    std::array<const char *, kItemCount> keys{};
-    std::size_t idx = 0;
-    for_each_type<Tuple>([&]<typename Node>() {
-        if constexpr (IsItem<Node>) {
-            keys[idx++] = Node::key.c_str();
-        }
-    });
-    // Compare all pairs
-    for (std::size_t i = 0; i < keys.size(); ++i) {
-        for (std::size_t j = i + 1; j < keys.size(); ++j) {
-            // simple C-string compare
-            const char *a = keys[i];
-            const char *b = keys[j];
-            std::size_t k = 0;
-            while (a[k] != '\0' && a[k] == b[k])
-                ++k;
-            if (a[k] == '\0' && b[k] == '\0')
-                return false; // duplicate found
-        }
-    }
-    return true;
-}
-static_assert(check_unique_keys<Schema>(), "Duplicate keys in schema");
-
-// without checking for performance
-union Value {
-    template <typename T> Value &operator=(T v) {
-        if constexpr (std::is_same_v<T, int>)
-            i = v;
-        else if constexpr (std::is_same_v<T, float>)
-            f = v;
-        return *this;
-    }
-    template <typename T> T &get() {
-        if constexpr (std::is_same_v<T, int>)
-            return i;
-        else if constexpr (std::is_same_v<T, float>)
-            return f;
-        else
-            static_assert(false, "Unsupported type");
-    }
-
-  private:
-    int i;
-    float f;
-};
+bool gEnabled = false;                              // runtime-loaded: [untitled] Enabled=0/1
 
 // =========================
 // Tiny helpers
@@ -634,8 +71,9 @@ template <typename T> void parse(const char *s, std::size_t n, T &out) {
 // =========================
 // global state for MyBlueprintModifyPostProcess
 // =========================
-std::atomic<float> myPostProcessBlendWeight = 0.f;
 SDK::FPostProcessSettings myPostProcessSettings = {};
+static triple_buffer<override_snapshot> gSnapshots;
+static uint64_t gSnapshotSerial = 0;
 
 // =========================
 // compile-time map of setters
@@ -668,6 +106,25 @@ static_assert(count_all_fields() == gSetters.size(), "Missing setter");
 #undef GBX_SETTER
 #undef ALL_SETTERS
 
+// and the matching getters, reporting the override flag alongside the value
+using Getter = bool (*)(const SDK::FPostProcessSettings &, float &);
+#define GETTER(Name)                                                                                                   \
+    {#Name, [](const SDK::FPostProcessSettings &s, float &v) {                                                         \
+         v = static_cast<float>(s.Name);                                                                               \
+         return static_cast<bool>(s.bOverride_##Name);                                                                 \
+     }}
+#define GBX_GETTER(Gbx, Name)                                                                                          \
+    {#Name, [](const SDK::FPostProcessSettings &s, float &v) {                                                         \
+         v = static_cast<float>(s.Gbx.Name);                                                                           \
+         return static_cast<bool>(s.Gbx.bOverride_##Name);                                                             \
+     }}
+#define ALL_GETTERS {FOR_EACH_SEP(COMMA, GETTER, PPS_FIELDS), FOR_EACH_SEP(COMMA, GBX_GETTER, GBX_PPS_TUPLES)}
+static constexpr auto gGetters = eternal::map<eternal::string, Getter>(ALL_GETTERS);
+static_assert(count_all_fields() == gGetters.size(), "Missing getter");
+#undef GETTER
+#undef GBX_GETTER
+#undef ALL_GETTERS
+
 template <ct_string Key, typename T> constexpr void apply_setting(bool o, T v) {
     constexpr auto setter = gSetters.find(Key.c_str());
     if constexpr (setter != gSetters.end()) {
@@ -677,14 +134,179 @@ template <ct_string Key, typename T> constexpr void apply_setting(bool o, T v) {
     }
 }
 
+// same setters, indexed by schema item order
+static consteval std::array<Setter, kItemCount> make_item_setters() {
+    std::array<Setter, kItemCount> setters{};
+    std::size_t idx = 0;
+    for_each_type<Schema>([&]<typename Node>() {
+        if constexpr (IsItem<Node>)
+            setters[idx++] = gSetters.find(Node::key.c_str())->second;
+    });
+    return setters;
+}
+static constexpr auto gItemSetters = make_item_setters();
+
+static consteval std::array<Getter, kItemCount> make_item_getters() {
+    std::array<Getter, kItemCount> getters{};
+    std::size_t idx = 0;
+    for_each_type<Schema>([&]<typename Node>() {
+        if constexpr (IsItem<Node>)
+            getters[idx++] = gGetters.find(Node::key.c_str())->second;
+    });
+    return getters;
+}
+static constexpr auto gItemGetters = make_item_getters();
+
+// =========================
+// Gbx sub-struct blocks, in GBX_PPS_TUPLES order
+// =========================
+struct gbx_block {
+    const char *name;
+    std::size_t offset;
+    std::size_t size;
+    bool SDK::FPostProcessSettings::*show;
+};
+#define GBX_BLOCK(Gbx) GBX_BLOCK_(Gbx)
+#define GBX_BLOCK_(Gbx)                                                                                                \
+    gbx_block {                                                                                                        \
+        #Gbx, offsetof(SDK::FPostProcessSettings, Gbx), sizeof(SDK::FPostProcessSettings::Gbx),                        \
+            &SDK::FPostProcessSettings::bShow##Gbx                                                                     \
+    }
+static constexpr std::array<gbx_block, kGbxBlocks> kGbxBlockDescs = {
+    GBX_BLOCK(GBX_ED2_FIELD), GBX_BLOCK(GBX_ED_FIELD), GBX_BLOCK(GBX_OUTLINE_FIELD), GBX_BLOCK(GBX_KUWAHARA_FIELD),
+    GBX_BLOCK(GBX_RENDER_FIELD)};
+#undef GBX_BLOCK
+#undef GBX_BLOCK_
+
+static consteval std::array<uint8_t, kItemCount> make_item_blocks() {
+    struct field {
+        std::string_view block;
+        std::string_view name;
+    };
+#define GBX_FIELD(Gbx, Name) field{#Gbx, #Name}
+    constexpr field fields[] = {FOR_EACH_SEP(COMMA, GBX_FIELD, GBX_PPS_TUPLES)};
+#undef GBX_FIELD
+    std::array<uint8_t, kItemCount> blocks{};
+    for (std::size_t i = 0; i < kItemCount; ++i) {
+        blocks[i] = kGbxBlocks;
+        for (const auto &f : fields)
+            if (f.name == kItems[i].key)
+                for (std::size_t b = 0; b < kGbxBlocks; ++b)
+                    if (f.block == kGbxBlockDescs[b].name)
+                        blocks[i] = static_cast<uint8_t>(b);
+    }
+    return blocks;
+}
+constexpr std::array<uint8_t, kItemCount> gItemBlocks = make_item_blocks();
+
+// the Gbx blocks as of the last publish; a block whose bytes changed since then is dirty
+static SDK::FPostProcessSettings gGbxPublished{};
+static uint8_t gGbxActive = 0;
+static std::array<uint64_t, kGbxBlocks> gGbxSerials{};
+
+static void sync_gbx_blocks() {
+    const auto now = reinterpret_cast<const uint8_t *>(&myPostProcessSettings);
+    const auto then = reinterpret_cast<uint8_t *>(&gGbxPublished);
+    for (std::size_t b = 0; b < kGbxBlocks; ++b) {
+        const auto &block = kGbxBlockDescs[b];
+        if (std::memcmp(now + block.offset, then + block.offset, block.size) == 0)
+            continue;
+        std::memcpy(then + block.offset, now + block.offset, block.size);
+        ++gGbxSerials[b];
+        bool active = false;
+        for (std::size_t i = 0; i < kItemCount && !active; ++i)
+            if (float value = 0.f; gItemBlocks[i] == b)
+                active = gItemGetters[i](myPostProcessSettings, value);
+        gGbxActive = static_cast<uint8_t>(active ? gGbxActive | 1u << b : gGbxActive & ~(1u << b));
+    }
+    // each setter writes its block's gate from its own flag, leaving whichever item was applied last
+    for (std::size_t b = 0; b < kGbxBlocks; ++b)
+        myPostProcessSettings.*kGbxBlockDescs[b].show = (gGbxActive >> b & 1u) != 0;
+}
+
 // =========================
 // Runtime storage item(enabled + value + changed) / group(opened), aligned with schema item order
 // =========================
-static std::array<bool, kItemCount> gEnables{};
-static std::array<Value, kItemCount> gValues{};
+std::array<bool, kItemCount> gEnables{};
+std::array<Value, kItemCount> gValues{};
 static std::array<bool, kItemCount> gChanges{};
 static std::array<bool, kGroupCount> gOpens{};
 
+// =========================
+// Hash of the active override set (FNV-1a over the gate and every enabled item), used to tag frame samples
+// =========================
+static uint32_t hash_overrides() {
+    uint32_t h = 2166136261u;
+    auto mix = [&](uint32_t v) {
+        for (int shift = 0; shift < 32; shift += 8) {
+            h ^= (v >> shift) & 0xffu;
+            h *= 16777619u;
+        }
+    };
+    mix(gEnabled ? 1u : 0u);
+    for (std::size_t i = 0; i < kItemCount; ++i) {
+        if (gEnables[i]) {
+            mix(static_cast<uint32_t>(i));
+            mix(std::bit_cast<uint32_t>(gValues[i]));
+        }
+    }
+    return h;
+}
+
+void set_own_item(SDK::FPostProcessSettings &settings, std::size_t idx, bool enabled, float value) {
+    gItemSetters[idx](settings, enabled, value);
+}
+
+bool get_own_item(const SDK::FPostProcessSettings &settings, std::size_t idx, float &value) {
+    return gItemGetters[idx](settings, value);
+}
+
+void set_item(SDK::FPostProcessSettings &settings, std::size_t idx, bool enabled, float value) {
+    if (GLayoutMode.load(std::memory_order_relaxed) != LayoutMode::Compiled) [[unlikely]]
+        return WriteLiveItem(settings, idx, enabled, value);
+    gItemSetters[idx](settings, enabled, value);
+}
+
+bool get_item(const SDK::FPostProcessSettings &settings, std::size_t idx, float &value) {
+    if (GLayoutMode.load(std::memory_order_relaxed) != LayoutMode::Compiled) [[unlikely]]
+        return ReadLiveItem(settings, idx, value);
+    return gItemGetters[idx](settings, value);
+}
+
+void apply_item(std::size_t idx) {
+    const float v = kItems[idx].is_int ? static_cast<float>(gValues[idx].get<int>()) : gValues[idx].get<float>();
+    gItemSetters[idx](myPostProcessSettings, gEnables[idx], v);
+}
+
+void publish_overrides() {
+    auto &snapshot = gSnapshots.back();
+    snapshot.serial = ++gSnapshotSerial;
+    snapshot.weight = gEnabled ? 1.f : 0.f;
+    sync_gbx_blocks();
+    snapshot.settings = myPostProcessSettings;
+    snapshot.gbx_active = gGbxActive;
+    snapshot.gbx_serials = gGbxSerials;
+    fill_curves(snapshot);
+    fill_zones(snapshot);
+    fill_view(snapshot);
+    gSnapshots.publish();
+}
+
+const override_snapshot &read_overrides() { return gSnapshots.read(); }
+const override_snapshot &current_overrides() { return gSnapshots.current(); }
+
+// the override set changed: retag frame samples and hand the new state to the game thread
+static void commit_overrides() {
+    set_frame_tag(hash_overrides());
+    publish_overrides();
+}
+
+void apply_overrides() {
+    for (std::size_t i = 0; i < kItemCount; ++i)
+        apply_item(i);
+    commit_overrides();
+}
+
 // =========================
 // Loading current preset values into runtime arrays (no defaults; absent -> 0/false)
 // =========================
@@ -698,7 +320,6 @@ static void load_all_from_preset(reshade::api::effect_runtime *runtime) {
     else
         gEnabled = false; // absent -> off
 
-    myPostProcessBlendWeight.store(gEnabled ? 1.f : 0.f, std::memory_order_release);
     LOG(INFO) << "Untitled " << (gEnabled ? "enabled" : "disabled");
     // Per item: read "<Key>.Enabled" and "<Key>.Value" using compile-time expansion over schema
     std::size_t idx = 0;
@@ -720,14 +341,177 @@ static void load_all_from_preset(reshade::api::effect_runtime *runtime) {
             ++idx;
         }
     });
+    load_curves(runtime);
+    load_zones(runtime);
+    load_view(runtime);
+    load_presets(runtime);
+    load_mixer(runtime);
+    commit_overrides();
+    reset_journal();
+    load_cvars(runtime);
+    load_governor(runtime);
     LOG(INFO) << "Loaded all from preset";
 }
 
+void save_overrides(reshade::api::effect_runtime *runtime) {
+    set_config(runtime, "Enabled", gEnabled);
+    std::size_t idx = 0;
+    for_each_type<Schema>([&]<typename Node>() {
+        if constexpr (IsItem<Node>) {
+            set_config(runtime, Node::key_enabled.c_str(), gEnables[idx]);
+            set_config(runtime, Node::key_value.c_str(), gValues[idx].get<typename Node::value_type>());
+            ++idx;
+        }
+    });
+    LOG(INFO) << "Wrote all to preset";
+}
+
+// =========================
+// Item editing shared by the grouped and the search views
+// =========================
+struct item_config_keys {
+    const char *enabled;
+    const char *value;
+};
+static consteval std::array<item_config_keys, kItemCount> make_item_config_keys() {
+    std::array<item_config_keys, kItemCount> keys{};
+    std::size_t idx = 0;
+    for_each_type<Schema>([&]<typename Node>() {
+        if constexpr (IsItem<Node>)
+            keys[idx++] = {Node::key_enabled.c_str(), Node::key_value.c_str()};
+    });
+    return keys;
+}
+static constexpr auto gItemConfigKeys = make_item_config_keys();
+
+void save_item(reshade::api::effect_runtime *runtime, std::size_t idx) {
+    set_config(runtime, gItemConfigKeys[idx].enabled, gEnables[idx]);
+    if (kItems[idx].is_int)
+        set_config(runtime, gItemConfigKeys[idx].value, gValues[idx].get<int>());
+    else
+        set_config(runtime, gItemConfigKeys[idx].value, gValues[idx].get<float>());
+}
+
+void save_gate(reshade::api::effect_runtime *runtime) { set_config(runtime, "Enabled", gEnabled); }
+
+// persists what changed right away, and applies and publishes once the widget lets go of the value
+static void commit_item_edit(reshade::api::effect_runtime *runtime, std::size_t idx, bool enabled_changed,
+                             bool value_changed, bool deactivated) {
+    const bool is_int = kItems[idx].is_int;
+    if (enabled_changed)
+        set_config(runtime, gItemConfigKeys[idx].enabled, gEnables[idx]);
+    if (value_changed) {
+        if (is_int)
+            set_config(runtime, gItemConfigKeys[idx].value, gValues[idx].get<int>());
+        else
+            set_config(runtime, gItemConfigKeys[idx].value, gValues[idx].get<float>());
+    }
+    if (enabled_changed || value_changed)
+        gChanges[idx] = true;
+    if (!(deactivated || enabled_changed) || !gChanges[idx])
+        return;
+    gChanges[idx] = false;
+    apply_item(idx);
+    commit_overrides();
+    journal_item(idx);
+    if (!gEnables[idx])
+        LOG(INFO) << "Disabled: " << kItems[idx].key;
+    else if (is_int)
+        LOG(INFO) << "Enabled: " << kItems[idx].key << " = " << gValues[idx].get<int>();
+    else
+        LOG(INFO) << "Enabled: " << kItems[idx].key << " = " << gValues[idx].get<float>();
+}
+
+// flags items the live layout check (layout.h) could not match
+static void draw_item_status(std::size_t idx) {
+    const auto status = PostProcessFieldStatus(idx);
+    if (status == FieldStatus::Ok)
+        return;
+    ImGui::SameLine();
+    ImGui::TextDisabled("(%s)", FieldStatusName(status));
+    if (ImGui::IsItemHovered())
+        ImGui::SetTooltip(status == FieldStatus::Missing
+                              ? "This game build has no such override; it is kept but never written"
+                              : "Delivered through the live layout, see LAYOUT");
+}
+
+static bool draw_item_value(std::size_t idx) {
+    const auto &item = kItems[idx];
+    if (item.is_int) {
+        auto &value = gValues[idx].get<int>();
+        if (item.ranged)
+            return ImGui::SliderInt("##value", &value, static_cast<int>(item.min), static_cast<int>(item.max));
+        return ImGui::InputInt("##value", &value);
+    }
+    auto &value = gValues[idx].get<float>();
+    if (item.ranged)
+        return ImGui::SliderFloat("##value", &value, item.min, item.max, "%.3f");
+    return ImGui::InputFloat("##value", &value);
+}
+
+// flat, clipped table of the items matching the search box and/or the "modified only" filter
+static void draw_item_matches(reshade::api::effect_runtime *runtime, const char *query, bool modified_only) {
+    static std::vector<uint16_t> rows;
+    const auto &matches = search_items(query);
+    const std::vector<uint16_t> *shown = &matches;
+    if (modified_only) {
+        rows.clear();
+        for (const auto idx : matches)
+            if (gEnables[idx])
+                rows.push_back(idx);
+        shown = &rows;
+    }
+    ImGui::TextDisabled("%zu of %zu items (%.1f us)", shown->size(), kItemCount, search_index_stats().query_us);
+    if (shown->empty())
+        return;
+
+    constexpr auto flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY |
+                           ImGuiTableFlags_SizingStretchProp;
+    if (!ImGui::BeginTable("##matches", 4, flags, ImVec2(0, 420)))
+        return;
+    ImGui::TableSetupScrollFreeze(0, 1);
+    ImGui::TableSetupColumn("On", ImGuiTableColumnFlags_WidthFixed);
+    ImGui::TableSetupColumn("Item", ImGuiTableColumnFlags_WidthStretch, 3.f);
+    ImGui::TableSetupColumn("Value", ImGuiTableColumnFlags_WidthStretch, 2.f);
+    ImGui::TableSetupColumn("Group", ImGuiTableColumnFlags_WidthStretch, 1.f);
+    ImGui::TableHeadersRow();
+    ImGuiListClipper clipper;
+    clipper.Begin(static_cast<int>(shown->size()));
+    while (clipper.Step()) {
+        for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+            const std::size_t idx = (*shown)[row];
+            ImGui::PushID(static_cast<int>(idx));
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            const bool enabled_changed = ImGui::Checkbox("##enabled", &gEnables[idx]);
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(kItems[idx].key);
+            if (*kItems[idx].info && ImGui::IsItemHovered())
+                ImGui::SetTooltip("%s", kItems[idx].info);
+            draw_item_status(idx);
+            ImGui::TableNextColumn();
+            bool value_changed = false;
+            bool deactivated = false;
+            if (gEnables[idx]) {
+                ImGui::SetNextItemWidth(-FLT_MIN);
+                value_changed = draw_item_value(idx);
+                deactivated = ImGui::IsItemDeactivatedAfterEdit();
+            }
+            ImGui::TableNextColumn();
+            ImGui::TextDisabled("%s", kGroupTitles[kItems[idx].group]);
+            ImGui::PopID();
+            commit_item_edit(runtime, idx, enabled_changed, value_changed, deactivated);
+        }
+    }
+    ImGui::EndTable();
+}
+
 // =========================
 // Overlay drawing (compile-time expanded per item kind)
 // =========================
 static void draw_overlay(reshade::api::effect_runtime *runtime) {
     runtime->block_input_next_frame(); // block input while overlay visible
+    journal_shortcuts(runtime);
 
     // Global master toggle
     bool opened = ImGui::CollapsingHeader("GLOBAL", ImGuiTreeNodeFlags_DefaultOpen);
@@ -741,23 +525,162 @@ static void draw_overlay(reshade::api::effect_runtime *runtime) {
     if (IS_HOVERED)                                                                                                    \
         ImGui::SetTooltip("Global gate for all overrides");
 
+        ImGui::BeginDisabled(ab_test_running() || sweep_running() || mixer_running());
         bool changed = ImGui::Checkbox("##enabled", &gEnabled);
+        ImGui::EndDisabled();
         SET_TOOL_TIP;
-        if (changed)
-            set_config(runtime, "Enabled", gEnabled);
-        myPostProcessBlendWeight.store(gEnabled ? 1.f : 0.f, std::memory_order_release);
+        if (changed) {
+            save_gate(runtime);
+            commit_overrides();
+            journal_gate();
+            if (gEnabled)
+                apply_cvars();
+            else
+                revert_cvars();
+        }
         ImGui::SameLine();
         ImGui::TextUnformatted("<-- ENABLED");
         SET_TOOL_TIP;
 
 #undef SET_TOOL_TIP
 
+        if (const auto hooked = GTimeToHook.load(std::memory_order_relaxed); hooked >= 0)
+            ImGui::TextDisabled("Hooked %.1f ms after load (engine ready at %.1f ms)", hooked / 1000.0,
+                                GTimeToReady.load(std::memory_order_relaxed) / 1000.0);
+        else
+            ImGui::TextDisabled("Waiting for the engine...");
+        ImGui::TextDisabled("Camera modifier installed %u times, re-armed %u times",
+                            GModifierInstalls.load(std::memory_order_relaxed),
+                            GModifierRearms.load(std::memory_order_relaxed));
+        ImGui::TextDisabled("Game-thread tasks: %llu pending, %llu run, %llu over budget",
+                            static_cast<unsigned long long>(GGameTasksPending.load(std::memory_order_relaxed)),
+                            static_cast<unsigned long long>(GGameTasksRun.load(std::memory_order_relaxed)),
+                            static_cast<unsigned long long>(GGameTaskOverruns.load(std::memory_order_relaxed)));
+
+        ImGui::Unindent();
+    }
+
+    if (ImGui::CollapsingHeader("FRAME TIMES")) {
+        ImGui::Indent();
+        draw_frame_stats();
+        ImGui::Unindent();
+    }
+
+    if (ImGui::CollapsingHeader("PROFILER")) {
+        ImGui::Indent();
+        DrawProfiler();
+        ImGui::Unindent();
+    }
+
+    if (ImGui::CollapsingHeader("DELIVERY")) {
+        ImGui::Indent();
+        DrawDelivery();
+        ImGui::Unindent();
+    }
+
+    if (ImGui::CollapsingHeader("REFLECTION")) {
+        ImGui::Indent();
+        DrawReflection();
+        ImGui::Unindent();
+    }
+
+    if (ImGui::CollapsingHeader("LAYOUT")) {
+        ImGui::Indent();
+        DrawLayout();
+        ImGui::Unindent();
+    }
+
+    if (ImGui::CollapsingHeader("CENSUS")) {
+        ImGui::Indent();
+        DrawCensus();
+        ImGui::Unindent();
+    }
+
+    if (ImGui::CollapsingHeader("STREAMING")) {
+        ImGui::Indent();
+        DrawStreaming();
+        ImGui::Unindent();
+    }
+
+    if (ImGui::CollapsingHeader("TICKS")) {
+        ImGui::Indent();
+        DrawTickInventory();
         ImGui::Unindent();
     }
 
-    if (!gEnabled)
+    if (ImGui::CollapsingHeader("PRESET LIBRARY")) {
+        ImGui::Indent();
+        draw_presets(runtime);
+        ImGui::Unindent();
+    }
+    if (ImGui::CollapsingHeader("PRESET MIXER")) {
+        ImGui::Indent();
+        draw_mixer(runtime);
+        ImGui::Unindent();
+    }
+    if (ImGui::CollapsingHeader("HISTORY")) {
+        ImGui::Indent();
+        draw_journal(runtime);
+        ImGui::Unindent();
+    }
+
+    if (ImGui::CollapsingHeader("CONSOLE VARIABLES")) {
+        ImGui::Indent();
+        draw_cvars(runtime);
+        ImGui::Unindent();
+    }
+
+    if (ImGui::CollapsingHeader("TIME OF DAY")) {
+        ImGui::Indent();
+        draw_curves(runtime);
+        ImGui::Unindent();
+    }
+
+    if (ImGui::CollapsingHeader("ZONES")) {
+        ImGui::Indent();
+        draw_zones(runtime);
+        ImGui::Unindent();
+    }
+
+    if (ImGui::CollapsingHeader("VIEW")) {
+        ImGui::Indent();
+        draw_view(runtime);
+        ImGui::Unindent();
+    }
+
+    if (ImGui::CollapsingHeader("GOVERNOR")) {
+        ImGui::Indent();
+        draw_governor(runtime);
+        ImGui::Unindent();
+    }
+
+    if (ImGui::CollapsingHeader("SCALABILITY SWEEP")) {
+        ImGui::Indent();
+        draw_sweep();
+        ImGui::Unindent();
+    }
+
+    if (ImGui::CollapsingHeader("A/B TEST")) {
+        ImGui::Indent();
+        draw_ab_test();
+        ImGui::Unindent();
+    }
+
+    // a running A/B test or mix owns the override state until it restores it
+    if (!gEnabled || ab_test_running() || mixer_running())
         return;
 
+    // either filter replaces the groups below with one flat table of matches
+    static char query[64]{};
+    static bool modified_only = false;
+    ImGui::InputTextWithHint("##search", "Search keys and tooltips", query, sizeof(query));
+    ImGui::SameLine();
+    ImGui::Checkbox("Modified only", &modified_only);
+    if (*query || modified_only) {
+        draw_item_matches(runtime, query, modified_only);
+        return;
+    }
+
     std::size_t idx = 0;
     std::size_t gidx = 0;
     bool have_group = false;
@@ -801,6 +724,7 @@ static void draw_overlay(reshade::api::effect_runtime *runtime) {
                 ImGui::SameLine();
                 ImGui::TextUnformatted(Node::key.c_str());
                 SET_TOOL_TIP;
+                draw_item_status(idx);
 
                 bool value_changed = false;
                 auto &value = gValues[idx].get<typename Node::value_type>();
@@ -825,20 +749,7 @@ static void draw_overlay(reshade::api::effect_runtime *runtime) {
 
                 ImGui::PopID();
 
-                if (enabled_changed)
-                    set_config(runtime, Node::key_enabled.c_str(), enabled);
-                if (value_changed)
-                    set_config(runtime, Node::key_value.c_str(), value);
-                if (enabled_changed || value_changed)
-                    gChanges[idx] = true;
-                if ((deactivated || enabled_changed) && gChanges[idx]) {
-                    gChanges[idx] = false;
-                    apply_setting<Node::key>(enabled, value);
-                    if (enabled)
-                        LOG(INFO) << "Enabled: " << Node::key.c_str() << " = " << value;
-                    else
-                        LOG(INFO) << "Disabled: " << Node::key.c_str();
-                }
+                commit_item_edit(runtime, idx, enabled_changed, value_changed, deactivated);
             }
             ++idx;
         }
@@ -852,8 +763,25 @@ static void draw_overlay(reshade::api::effect_runtime *runtime) {
 // =========================
 // ReShade add-on wiring
 // =========================
-static void on_init_runtime(reshade::api::effect_runtime *rt) { load_all_from_preset(rt); }
-static void on_preset_changed(reshade::api::effect_runtime *rt, const char * /*path*/) { load_all_from_preset(rt); }
+static void on_init_runtime(reshade::api::effect_runtime *rt) {
+    NotifyEngineMaybeReady(); // the engine usually finishes booting around the time the first runtime comes up
+    load_all_from_preset(rt);
+}
+static void on_preset_changed(reshade::api::effect_runtime *rt, const char * /*path*/) {
+    cancel_ab_test(); // the preset replaces whatever the run would have restored
+    cancel_sweep();
+    load_all_from_preset(rt);
+}
+static void on_present(reshade::api::effect_runtime * /*rt*/) {
+    record_frame();
+    WatchCameraModifier();
+    step_ab_test();
+    step_sweep();
+    step_governor();
+    step_cvars();
+    step_zones();
+    step_mixer();
+}
 static void overlay_cb(reshade::api::effect_runtime *rt) { draw_overlay(rt); }
 
 // =========================
@@ -903,6 +831,7 @@ extern "C" __declspec(dllexport) bool AddonInit(HMODULE addon_module, HMODULE re
 
     reshade::register_event<reshade::addon_event::init_effect_runtime>(on_init_runtime);
     reshade::register_event<reshade::addon_event::reshade_set_current_preset_path>(on_preset_changed);
+    reshade::register_event<reshade::addon_event::reshade_present>(on_present);
     reshade::register_overlay(kOverlay, overlay_cb);
 
     InstallHook();
@@ -914,6 +843,7 @@ extern "C" __declspec(dllexport) void AddonUninit(HMODULE addon_module) {
     UninstallHook();
 
     reshade::unregister_overlay(kOverlay, overlay_cb);
+    reshade::unregister_event<reshade::addon_event::reshade_present>(on_present);
     reshade::unregister_event<reshade::addon_event::reshade_set_current_preset_path>(on_preset_changed);
     reshade::unregister_event<reshade::addon_event::init_effect_runtime>(on_init_runtime);
 
@@ -1,6 +1,52 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+
 #include <SDK/Engine_structs.hpp>
 
-extern std::atomic<float> myPostProcessBlendWeight;
-extern SDK::FPostProcessSettings myPostProcessSettings;
\ No newline at end of file
+namespace reshade::api {
+struct effect_runtime;
+}
+
+#include "schema.h"
+#include "snapshot.h"
+
+inline constexpr const char *kSection = "untitled"; // preset section every override is stored under
+
+// render thread's working copy; the game thread only ever sees it through read_overrides()
+extern SDK::FPostProcessSettings myPostProcessSettings;
+
+// Gbx block of each schema item (see snapshot.h), kGbxBlocks for fields of FPostProcessSettings itself
+extern const std::array<uint8_t, kItemCount> gItemBlocks;
+
+// runtime override state (render thread), aligned with schema item order
+extern bool gEnabled;
+extern std::array<bool, kItemCount> gEnables;
+extern std::array<Value, kItemCount> gValues;
+
+// pushes gEnables[idx]/gValues[idx] into myPostProcessSettings
+extern void apply_item(std::size_t idx);
+// pushes the gate and every item, then retags frame samples with the new override set
+extern void apply_overrides();
+// writes one schema item into a settings struct the game owns, e.g. the one handed to BlueprintModifyPostProcess;
+// goes through the live layout (layout.h) when the game's FPostProcessSettings no longer matches the SDK
+extern void set_item(SDK::FPostProcessSettings &settings, std::size_t idx, bool enabled, float value);
+// reads one schema item back; returns its override flag
+extern bool get_item(const SDK::FPostProcessSettings &settings, std::size_t idx, float &value);
+// the same through the SDK's offsets only, for structs we own (our working copy, snapshots, probes)
+extern void set_own_item(SDK::FPostProcessSettings &settings, std::size_t idx, bool enabled, float value);
+extern bool get_own_item(const SDK::FPostProcessSettings &settings, std::size_t idx, float &value);
+
+// writes the gate and every item into the current ReShade preset (render thread)
+extern void save_overrides(reshade::api::effect_runtime *runtime);
+// the same for one item, or the gate alone
+extern void save_item(reshade::api::effect_runtime *runtime, std::size_t idx);
+extern void save_gate(reshade::api::effect_runtime *runtime);
+
+// copies the current override state into a fresh snapshot for the game thread (render thread)
+extern void publish_overrides();
+// newest published snapshot; valid until the next call (game thread)
+extern const override_snapshot &read_overrides();
+// the snapshot the last read_overrides() returned, for a second call in the same camera update (game thread)
+extern const override_snapshot &current_overrides();
@@ -0,0 +1,363 @@
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string_view>
+#include <unordered_map>
+
+#include <imgui.h>
+
+#include <easylogging++.h>
+
+#include <SDK/Engine_classes.hpp>
+
+#include "census.h"
+#include "handle.h"
+
+std::atomic<uint32_t> GCensusBudgetUs = 500;
+std::atomic<uint32_t> GCensusSliceItems = 4096;
+std::atomic<uint32_t> GCensusIntervalS = 0;
+std::atomic<std::shared_ptr<const CensusSnapshot>> GCensusLatest;
+
+namespace {
+
+constexpr uint32_t kClockStride = 64; // items between budget checks
+
+std::atomic_bool GCensusRequested = false;
+
+enum class CensusPhase : int { Idle, Actors, Components, Finish };
+std::atomic<CensusPhase> GPhase = CensusPhase::Idle;
+std::atomic<uint32_t> GProgress = 0; // per mille of the current phase, for the overlay
+
+// =========================
+// Work in progress (game thread)
+// =========================
+struct Census {
+    std::vector<ObjectHandle> Levels;
+    std::vector<std::string> LevelNames;
+    std::unordered_map<SDK::UObject *, uint16_t> LevelSlots;
+    uint32_t Level = 0;  // Actors: current level and actor
+    int32_t Actor = 0;
+    int32_t Object = 0; // Components: next GObjects index
+
+    // (level slot << 33) | (component << 32) | class index
+    std::unordered_map<uint64_t, uint32_t> Counts;
+    std::unordered_map<int32_t, std::string> ClassNames;
+    std::unordered_map<int32_t, bool> ComponentClasses;
+
+    CensusSnapshot Result;
+    std::chrono::steady_clock::time_point LastFinished;
+};
+Census GCensus;
+uint64_t GCensusNumber = 0;
+
+uint64_t Key(uint16_t level, bool component, int32_t classIndex) {
+    return uint64_t{level} << 33 | uint64_t{component} << 32 | static_cast<uint32_t>(classIndex);
+}
+
+void CountObject(uint16_t level, bool component, SDK::UClass *type) {
+    if (!GCensus.ClassNames.contains(type->Index))
+        GCensus.ClassNames.emplace(type->Index, type->GetName());
+    ++GCensus.Counts[Key(level, component, type->Index)];
+}
+
+bool IsComponentClass(SDK::UClass *type) {
+    auto [it, inserted] = GCensus.ComponentClasses.try_emplace(type->Index, false);
+    if (inserted)
+        it->second = type->IsSubclassOf(SDK::UActorComponent::StaticClass());
+    return it->second;
+}
+
+void Begin() {
+    auto world = SDK::UWorld::GetWorld();
+    if (!world)
+        return;
+    GCensus.Levels.clear();
+    GCensus.LevelNames.clear();
+    GCensus.LevelSlots.clear();
+    GCensus.Counts.clear();
+    GCensus.ClassNames.clear();
+    GCensus.ComponentClasses.clear();
+    GCensus.Level = 0;
+    GCensus.Actor = 0;
+    GCensus.Object = 0;
+    GCensus.Result = {.Number = ++GCensusNumber, .Taken = std::chrono::system_clock::now()};
+
+    for (int32_t i = 0; i < world->levels.Num() && GCensus.Levels.size() < 0xffff; ++i) {
+        auto level = world->levels[i];
+        if (!level || GCensus.LevelSlots.contains(level))
+            continue;
+        GCensus.LevelSlots.emplace(level, static_cast<uint16_t>(GCensus.Levels.size()));
+        GCensus.Levels.push_back(ObjectHandle::Of(level));
+        GCensus.LevelNames.push_back(level->Outer ? level->Outer->GetName() : level->GetName());
+    }
+    auto &result = GCensus.Result;
+    result.Levels = static_cast<uint32_t>(GCensus.Levels.size());
+    for (int32_t i = 0; i < world->StreamingLevels.Num(); ++i) {
+        auto streaming = world->StreamingLevels[i];
+        if (!streaming)
+            continue;
+        ++result.StreamingLevels;
+        if (auto loaded = streaming->LoadedLevel) {
+            ++result.StreamingLoaded;
+            result.StreamingVisible += loaded->bIsVisible;
+        }
+    }
+    GPhase.store(CensusPhase::Actors, std::memory_order_relaxed);
+}
+
+// each step handles one item and says whether there is more
+bool StepActors() {
+    if (GCensus.Level >= GCensus.Levels.size())
+        return false;
+    auto level = GCensus.Levels[GCensus.Level].Get<SDK::ULevel>();
+    if (!level || GCensus.Actor >= level->Actors.Num()) {
+        ++GCensus.Level;
+        GCensus.Actor = 0;
+        GProgress.store(static_cast<uint32_t>(GCensus.Level * 1000 / GCensus.Levels.size()), std::memory_order_relaxed);
+        return true;
+    }
+    auto actor = level->Actors[GCensus.Actor++];
+    if (actor && actor->Class) {
+        CountObject(static_cast<uint16_t>(GCensus.Level), false, actor->Class);
+        ++GCensus.Result.Actors;
+    }
+    return true;
+}
+
+bool StepComponents() {
+    const auto count = SDK::UObject::GObjects->Num();
+    if (GCensus.Object >= count)
+        return false;
+    const auto index = GCensus.Object++;
+    if ((index & 0xfff) == 0)
+        GProgress.store(static_cast<uint32_t>(int64_t{index} * 1000 / count), std::memory_order_relaxed);
+    auto item = ObjectHandle::Item(index);
+    auto object = item ? item->Object : nullptr;
+    if (!object || !object->Class || !object->Outer ||
+        (object->Flags & (SDK::EObjectFlags::ClassDefaultObject | SDK::EObjectFlags::ArchetypeObject)))
+        return true;
+    // components hang off their actor, which hangs off its level
+    auto owner = object->Outer;
+    if (!owner->Outer || !owner->IsA(SDK::EClassCastFlags::Actor) || object->IsA(SDK::EClassCastFlags::Actor))
+        return true;
+    auto slot = GCensus.LevelSlots.find(owner->Outer);
+    if (slot == GCensus.LevelSlots.end() || !IsComponentClass(object->Class))
+        return true;
+    CountObject(slot->second, true, object->Class);
+    ++GCensus.Result.Components;
+    return true;
+}
+
+void RecordSlice(std::chrono::steady_clock::time_point start) {
+    const auto us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    auto &result = GCensus.Result;
+    ++result.Slices;
+    result.GameThreadMs += us / 1000.0;
+    result.WorstSliceUs = std::max(result.WorstSliceUs, us);
+}
+
+void Finish(std::chrono::steady_clock::time_point start) {
+    auto &result = GCensus.Result;
+    const auto previous = GCensusLatest.load(std::memory_order_acquire);
+    result.Rows.reserve(GCensus.Counts.size());
+    for (const auto &[key, count] : GCensus.Counts) {
+        const auto classIndex = static_cast<int32_t>(key & 0xffffffff);
+        result.Rows.push_back({GCensus.LevelNames[key >> 33], GCensus.ClassNames[classIndex], classIndex,
+                               ((key >> 32) & 1) != 0, count, previous ? int64_t{count} : 0});
+    }
+
+    // deltas by (level, class index, kind); level slots are not stable across censuses, level names are
+    auto rowKey = [](const CensusRow &row) {
+        return row.Level + '\n' + std::to_string(row.ClassIndex) + (row.Component ? "c" : "a");
+    };
+    if (previous) {
+        std::unordered_map<std::string, std::size_t> index;
+        for (std::size_t i = 0; i < result.Rows.size(); ++i)
+            index.emplace(rowKey(result.Rows[i]), i);
+        for (const auto &old : previous->Rows) {
+            if (old.Count == 0)
+                continue;
+            if (auto it = index.find(rowKey(old)); it != index.end())
+                result.Rows[it->second].Delta -= old.Count;
+            else
+                result.Rows.push_back({old.Level, old.Class, old.ClassIndex, old.Component, 0, -int64_t{old.Count}});
+        }
+    }
+    std::ranges::sort(result.Rows, std::greater{}, &CensusRow::Count);
+    RecordSlice(start);
+
+    LOG(INFO) << "Census #" << result.Number << ": " << result.Actors << " actors, " << result.Components
+              << " components in " << result.Levels << " levels, " << result.Slices << " slices, "
+              << result.GameThreadMs << " ms game thread, worst slice " << result.WorstSliceUs << " us";
+    GCensusLatest.store(std::make_shared<const CensusSnapshot>(std::move(result)), std::memory_order_release);
+    GCensus.Result = {};
+    GCensus.Counts.clear();
+    GCensus.LastFinished = std::chrono::steady_clock::now();
+    GPhase.store(CensusPhase::Idle, std::memory_order_relaxed);
+}
+
+// =========================
+// Overlay helpers
+// =========================
+bool Matches(const std::string &name, const char *filter) {
+    if (!*filter)
+        return true;
+    auto it = std::ranges::search(name, std::string_view(filter), [](char a, char b) {
+        return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+    });
+    return !it.empty();
+}
+
+void ExportCsv(const CensusSnapshot &snapshot) {
+    using namespace std::chrono;
+    const auto stamp = std::to_string(duration_cast<seconds>(snapshot.Taken.time_since_epoch()).count());
+    const auto path = std::filesystem::current_path() / ("untitled-census-" + stamp + ".csv");
+    std::ofstream out(path);
+    out << "level,class,class_index,kind,count,delta\n";
+    for (const auto &row : snapshot.Rows)
+        out << '"' << row.Level << "\",\"" << row.Class << "\"," << row.ClassIndex << ','
+            << (row.Component ? "component" : "actor") << ',' << row.Count << ',' << row.Delta << '\n';
+    if (out)
+        LOG(INFO) << "Census written to " << path.string();
+    else
+        LOG(ERROR) << "Failed to write census to " << path.string();
+}
+
+} // namespace
+
+void RequestCensus() {
+    if (GPhase.load(std::memory_order_relaxed) == CensusPhase::Idle)
+        GCensusRequested.store(true, std::memory_order_relaxed);
+}
+
+void TickCensus() {
+    auto phase = GPhase.load(std::memory_order_relaxed);
+    if (phase == CensusPhase::Idle) {
+        const auto interval = GCensusIntervalS.load(std::memory_order_relaxed);
+        if (GCensusRequested.exchange(false, std::memory_order_relaxed) ||
+            (interval != 0 && std::chrono::steady_clock::now() - GCensus.LastFinished > std::chrono::seconds(interval)))
+            Begin();
+        return; // Begin() already walked the level lists; slicing starts next update
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    if (phase == CensusPhase::Finish) {
+        Finish(start);
+        return;
+    }
+    const auto budget = std::chrono::microseconds(GCensusBudgetUs.load(std::memory_order_relaxed));
+    const auto items = GCensusSliceItems.load(std::memory_order_relaxed);
+    for (uint32_t done = 0; done < items; ++done) {
+        if (done % kClockStride == kClockStride - 1 && std::chrono::steady_clock::now() - start >= budget)
+            break;
+        if (phase == CensusPhase::Actors && !StepActors()) {
+            phase = CensusPhase::Components;
+            GPhase.store(phase, std::memory_order_relaxed);
+        } else if (phase == CensusPhase::Components && !StepComponents()) {
+            GPhase.store(CensusPhase::Finish, std::memory_order_relaxed); // sorting and deltas get a slice of their own
+            break;
+        }
+    }
+    RecordSlice(start);
+}
+
+// =========================
+// Overlay panel
+// =========================
+void DrawCensus() {
+    static char filter[64]{};
+    static int sortBy = 0; // 0: count, 1: |delta|
+    static std::shared_ptr<const CensusSnapshot> shown;
+    static std::vector<const CensusRow *> rows;
+    static bool dirty = true;
+
+    const auto phase = GPhase.load(std::memory_order_relaxed);
+    ImGui::BeginDisabled(phase != CensusPhase::Idle);
+    if (ImGui::Button("Take census"))
+        RequestCensus();
+    ImGui::EndDisabled();
+    ImGui::SameLine();
+    if (phase == CensusPhase::Actors)
+        ImGui::Text("Counting actors... %.1f%%", GProgress.load(std::memory_order_relaxed) / 10.0);
+    else if (phase == CensusPhase::Components)
+        ImGui::Text("Counting components... %.1f%%", GProgress.load(std::memory_order_relaxed) / 10.0);
+    else if (phase == CensusPhase::Finish)
+        ImGui::TextUnformatted("Finishing...");
+
+    auto interval = static_cast<int>(GCensusIntervalS.load(std::memory_order_relaxed));
+    if (ImGui::SliderInt("Repeat every", &interval, 0, 300, interval ? "%d s" : "off"))
+        GCensusIntervalS.store(static_cast<uint32_t>(interval), std::memory_order_relaxed);
+    auto budget = static_cast<int>(GCensusBudgetUs.load(std::memory_order_relaxed));
+    if (ImGui::SliderInt("Budget per frame", &budget, 50, 5000, "%d us", ImGuiSliderFlags_Logarithmic))
+        GCensusBudgetUs.store(static_cast<uint32_t>(budget), std::memory_order_relaxed);
+    auto items = static_cast<int>(GCensusSliceItems.load(std::memory_order_relaxed));
+    if (ImGui::SliderInt("Items per frame", &items, 256, 65536, "%d", ImGuiSliderFlags_Logarithmic))
+        GCensusSliceItems.store(static_cast<uint32_t>(items), std::memory_order_relaxed);
+    if (ImGui::IsItemHovered())
+        ImGui::SetTooltip("Actors in the first pass, GObjects entries in the second; a slice ends at whichever of "
+                          "the two limits comes first");
+
+    if (auto latest = GCensusLatest.load(std::memory_order_acquire); latest != shown) {
+        shown = std::move(latest);
+        dirty = true;
+    }
+    if (!shown)
+        return;
+    ImGui::Separator();
+    ImGui::Text("Census #%llu: %llu actors, %llu components in %u levels",
+                static_cast<unsigned long long>(shown->Number), static_cast<unsigned long long>(shown->Actors),
+                static_cast<unsigned long long>(shown->Components), shown->Levels);
+    ImGui::TextDisabled("Streaming levels: %u, %u loaded, %u visible", shown->StreamingLevels, shown->StreamingLoaded,
+                        shown->StreamingVisible);
+    ImGui::TextDisabled("%u slices, %.2f ms on the game thread, worst slice %.0f us", shown->Slices,
+                        shown->GameThreadMs, shown->WorstSliceUs);
+    if (ImGui::Button("Export CSV"))
+        ExportCsv(*shown);
+
+    dirty |= ImGui::InputText("Filter", filter, sizeof(filter));
+    dirty |= ImGui::RadioButton("By count", &sortBy, 0);
+    ImGui::SameLine();
+    dirty |= ImGui::RadioButton("By change", &sortBy, 1);
+    if (dirty) {
+        rows.clear();
+        for (const auto &row : shown->Rows)
+            if (Matches(row.Class, filter) || Matches(row.Level, filter))
+                rows.push_back(&row);
+        if (sortBy == 1)
+            std::ranges::stable_sort(rows, std::greater{}, [](const CensusRow *row) { return std::abs(row->Delta); });
+        dirty = false;
+    }
+
+    constexpr auto flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY;
+    if (ImGui::BeginTable("##census", 5, flags, ImVec2(0, 320))) {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("Level");
+        ImGui::TableSetupColumn("Class");
+        ImGui::TableSetupColumn("Kind");
+        ImGui::TableSetupColumn("Count");
+        ImGui::TableSetupColumn("Change");
+        ImGui::TableHeadersRow();
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(rows.size()));
+        while (clipper.Step()) {
+            for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i) {
+                const auto &row = *rows[i];
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(row.Level.c_str());
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(row.Class.c_str());
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(row.Component ? "component" : "actor");
+                ImGui::TableNextColumn();
+                ImGui::Text("%u", row.Count);
+                ImGui::TableNextColumn();
+                if (row.Delta != 0)
+                    ImGui::Text("%+lld", static_cast<long long>(row.Delta));
+            }
+        }
+        ImGui::EndTable();
+    }
+}
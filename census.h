@@ -0,0 +1,49 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Incremental world census: actor and component counts per class per loaded level, gathered on the game thread in
+// slices so a full pass never costs a single frame more than the budget below.
+//  1. actors: every ULevel in UWorld::levels, walking ULevel::Actors
+//  2. components: GObjects, counting UActorComponents whose owning actor sits in one of those levels
+// The world keeps changing between slices, so a census is a smear over the frames it took, not an atomic snapshot.
+
+struct CensusRow {
+    std::string Level; // name of the level's UWorld
+    std::string Class;
+    int32_t ClassIndex; // GObjects index of the UClass, the histogram key
+    bool Component;
+    uint32_t Count;
+    int64_t Delta; // against the previous census; rows that vanished stay with Count 0
+};
+
+struct CensusSnapshot {
+    uint64_t Number = 0;
+    std::chrono::system_clock::time_point Taken;
+    std::vector<CensusRow> Rows; // by Count, descending
+    uint64_t Actors = 0;
+    uint64_t Components = 0;
+    uint32_t Levels = 0;
+    uint32_t StreamingLevels = 0; // UWorld::StreamingLevels, and how many of them are loaded / visible
+    uint32_t StreamingLoaded = 0;
+    uint32_t StreamingVisible = 0;
+    uint32_t Slices = 0;
+    double GameThreadMs = 0.0; // sum over all slices
+    double WorstSliceUs = 0.0;
+};
+
+extern std::atomic<uint32_t> GCensusBudgetUs;    // per slice; checked every few dozen items
+extern std::atomic<uint32_t> GCensusSliceItems;  // per slice, whichever limit comes first
+extern std::atomic<uint32_t> GCensusIntervalS;   // 0: only on request
+extern std::atomic<std::shared_ptr<const CensusSnapshot>> GCensusLatest;
+
+// any thread; ignored while a census is in progress
+extern void RequestCensus();
+// game thread, once per camera update; a couple of relaxed loads while idle
+extern void TickCensus();
+extern void DrawCensus();
@@ -0,0 +1,324 @@
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <imgui.h>
+#include <reshade.hpp>
+
+#include <easylogging++.h>
+
+#include <SDK/Engine_classes.hpp>
+#include <SDK/GbxTimeOfDay_classes.hpp>
+
+#include "addon.h"
+#include "curves.h"
+#include "handle.h"
+
+static constexpr float kDayHours = 24.f;
+
+// =========================
+// Curves (render thread)
+// =========================
+struct curve_key {
+    float hour;
+    float value;
+};
+
+struct tod_curve {
+    std::size_t item;
+    bool enabled = true;
+    std::vector<curve_key> keys; // sorted by hour, no duplicates
+};
+
+static std::vector<tod_curve> gCurves;
+static float gPreviewHour = -1.f;
+
+static float wrap_hour(float hour) {
+    hour = std::fmod(hour, kDayHours);
+    return hour < 0.f ? hour + kDayHours : hour;
+}
+
+static void normalize(tod_curve &curve) {
+    for (auto &key : curve.keys)
+        key.hour = wrap_hour(key.hour);
+    std::ranges::stable_sort(curve.keys, {}, &curve_key::hour);
+    auto dup = std::ranges::unique(curve.keys, {}, &curve_key::hour);
+    curve.keys.erase(dup.begin(), dup.end());
+}
+
+void fill_curves(override_snapshot &snapshot) {
+    snapshot.curves.clear();
+    snapshot.curve_hours.clear();
+    snapshot.curve_values.clear();
+    snapshot.preview_hour = gPreviewHour;
+    for (const auto &curve : gCurves) {
+        if (!curve.enabled || curve.keys.empty())
+            continue;
+        if (snapshot.curve_hours.size() + curve.keys.size() > std::numeric_limits<uint16_t>::max())
+            break;
+        snapshot.curves.push_back({static_cast<uint16_t>(curve.item),
+                                   static_cast<uint16_t>(snapshot.curve_hours.size()),
+                                   static_cast<uint16_t>(curve.keys.size())});
+        for (const auto &key : curve.keys) {
+            snapshot.curve_hours.push_back(key.hour);
+            snapshot.curve_values.push_back(key.value);
+        }
+    }
+}
+
+// =========================
+// Evaluation (game thread)
+// =========================
+static std::atomic<float> gLastHour = NAN;    // for the panel
+static std::atomic<float> gEvaluationNs = 0.f; // moving average over camera updates
+static ObjectHandle gClock;
+static uint32_t gClockRetry = 0;
+static std::vector<uint16_t> gSegments; // last segment per snapshot curve
+static uint64_t gSegmentsSerial = 0;
+
+// the world's time-of-day actor; once the cached one is gone, looked up again every 256 camera updates
+static SDK::AWorldTimeOfDayActor *find_clock() {
+    if (auto clock = gClock.Get<SDK::AWorldTimeOfDayActor>())
+        return clock;
+    if (gClockRetry++ % 256 != 0)
+        return nullptr;
+    auto world = SDK::UWorld::GetWorld();
+    gClock = ObjectHandle::Of(
+        world ? SDK::UGameplayStatics::GetActorOfClass(world, SDK::AWorldTimeOfDayActor::StaticClass()) : nullptr);
+    return gClock.Get<SDK::AWorldTimeOfDayActor>();
+}
+
+// segment s spans [hours[s], hours[s + 1]); the last one wraps past midnight to hours[0]
+static float sample(const float *hours, const float *values, uint16_t count, float hour, uint16_t &segment) {
+    if (count == 1)
+        return values[0];
+    auto contains = [&](uint16_t s) {
+        return s + 1 < count ? hours[s] <= hour && hour < hours[s + 1] : hour >= hours[s] || hour < hours[0];
+    };
+    if (segment >= count || !contains(segment)) {
+        const auto next = static_cast<uint16_t>(segment + 1 < count ? segment + 1 : 0);
+        if (segment < count && contains(next)) {
+            segment = next;
+        } else {
+            const auto upper = std::upper_bound(hours, hours + count, hour) - hours;
+            segment = static_cast<uint16_t>(upper == 0 ? count - 1 : upper - 1);
+        }
+    }
+    const auto from = hours[segment];
+    const auto to = segment + 1 < count ? hours[segment + 1] : hours[0] + kDayHours;
+    const auto at = hour < from ? hour + kDayHours : hour;
+    const auto t = to > from ? (at - from) / (to - from) : 0.f;
+    const auto last = segment + 1 < count ? segment + 1 : 0;
+    return std::lerp(values[segment], values[last], t);
+}
+
+void evaluate_curves(const override_snapshot &snapshot, SDK::FPostProcessSettings &settings) {
+    if (snapshot.curves.empty())
+        return;
+    const auto start = std::chrono::steady_clock::now();
+    auto hour = snapshot.preview_hour;
+    if (hour < 0.f) {
+        auto clock = find_clock();
+        if (!clock)
+            return;
+        hour = clock->bUseCinematicTimeOfDay ? clock->CinematicTimeOfDay : clock->TimeOfDay;
+    }
+    hour = wrap_hour(hour);
+    if (gSegmentsSerial != snapshot.serial) {
+        gSegments.assign(snapshot.curves.size(), 0);
+        gSegmentsSerial = snapshot.serial;
+    }
+    for (std::size_t i = 0; i < snapshot.curves.size(); ++i) {
+        const auto &curve = snapshot.curves[i];
+        auto value = sample(&snapshot.curve_hours[curve.first], &snapshot.curve_values[curve.first], curve.count, hour,
+                            gSegments[i]);
+        if (kItems[curve.item].is_int)
+            value = std::round(value);
+        set_item(settings, curve.item, true, value);
+    }
+    const auto ns = std::chrono::duration<float, std::nano>(std::chrono::steady_clock::now() - start).count();
+    gLastHour.store(hour, std::memory_order_relaxed);
+    gEvaluationNs.store(gEvaluationNs.load(std::memory_order_relaxed) * 0.95f + ns * 0.05f, std::memory_order_relaxed);
+}
+
+float current_hour() { return gLastHour.load(std::memory_order_relaxed); }
+
+// =========================
+// Preset storage
+// =========================
+static void save_curves(reshade::api::effect_runtime *runtime) {
+    std::string packed;
+    for (const auto &curve : gCurves) {
+        if (!packed.empty())
+            packed.push_back('\0');
+        packed += (curve.enabled ? "" : "#") + std::string(kItems[curve.item].key) + "=";
+        for (std::size_t k = 0; k < curve.keys.size(); ++k) {
+            char buf[64]{};
+            auto end = std::to_chars(std::begin(buf), std::end(buf), curve.keys[k].hour).ptr;
+            *end++ = ':';
+            end = std::to_chars(end, std::end(buf), curve.keys[k].value).ptr;
+            packed += (k ? "," : "") + std::string(buf, end);
+        }
+    }
+    reshade::set_config_value(runtime, kSection, "Curves", packed.c_str(), packed.size());
+}
+
+// "[#]Key=h:v,h:v,..."
+static bool parse_curve(std::string_view entry, tod_curve &curve) {
+    curve.enabled = !entry.starts_with('#');
+    if (!curve.enabled)
+        entry.remove_prefix(1);
+    const auto eq = entry.find('=');
+    if (eq == std::string_view::npos || (curve.item = find_item(entry.substr(0, eq))) >= kItemCount)
+        return false;
+    for (auto rest = entry.substr(eq + 1); !rest.empty();) {
+        auto comma = rest.find(',');
+        const auto pair = rest.substr(0, comma);
+        rest = comma == std::string_view::npos ? std::string_view() : rest.substr(comma + 1);
+        const auto colon = pair.find(':');
+        curve_key key{};
+        if (colon == std::string_view::npos ||
+            std::from_chars(pair.data(), pair.data() + colon, key.hour).ec != std::errc() ||
+            std::from_chars(pair.data() + colon + 1, pair.data() + pair.size(), key.value).ec != std::errc())
+            return false;
+        curve.keys.push_back(key);
+    }
+    normalize(curve);
+    return !curve.keys.empty();
+}
+
+void load_curves(reshade::api::effect_runtime *runtime) {
+    std::size_t size = 0;
+    std::string packed;
+    if (reshade::get_config_value(runtime, kSection, "Curves", nullptr, &size) && size > 0) {
+        packed.resize(size);
+        reshade::get_config_value(runtime, kSection, "Curves", packed.data(), &size);
+        packed.resize(size);
+    }
+    gCurves.clear();
+    for (std::size_t pos = 0; pos < packed.size();) {
+        auto end = packed.find('\0', pos);
+        if (end == std::string::npos)
+            end = packed.size();
+        if (tod_curve curve; parse_curve(std::string_view(packed).substr(pos, end - pos), curve))
+            gCurves.push_back(std::move(curve));
+        pos = end + 1;
+    }
+    LOG(INFO) << "Loaded " << gCurves.size() << " time-of-day curves";
+}
+
+// =========================
+// Overlay panel
+// =========================
+static float current_value(std::size_t item) {
+    return kItems[item].is_int ? static_cast<float>(gValues[item].get<int>()) : gValues[item].get<float>();
+}
+
+void draw_curves(reshade::api::effect_runtime *runtime) {
+    bool changed = false;
+    const auto hour = gLastHour.load(std::memory_order_relaxed);
+    if (std::isnan(hour))
+        ImGui::TextDisabled("No time of day seen yet");
+    else
+        ImGui::TextDisabled("Hour %05.2f, %zu curves evaluated in %.0f ns", hour, gCurves.size(),
+                            gEvaluationNs.load(std::memory_order_relaxed));
+
+    bool preview = gPreviewHour >= 0.f;
+    if (ImGui::Checkbox("Preview hour", &preview)) {
+        gPreviewHour = preview ? (std::isnan(hour) ? 12.f : hour) : -1.f;
+        publish_overrides(); // not saved: previewing is a tuning aid
+    }
+    if (preview) {
+        ImGui::SameLine();
+        if (ImGui::SliderFloat("##preview", &gPreviewHour, 0.f, kDayHours - 0.01f, "%05.2f"))
+            publish_overrides();
+    }
+
+    std::size_t remove = gCurves.size();
+    for (std::size_t c = 0; c < gCurves.size(); ++c) {
+        auto &curve = gCurves[c];
+        const auto &desc = kItems[curve.item];
+        ImGui::PushID(static_cast<int>(c));
+        changed |= ImGui::Checkbox("##enabled", &curve.enabled);
+        ImGui::SameLine();
+        const bool open = ImGui::TreeNode(desc.key, "%s (%zu keys)", desc.key, curve.keys.size());
+        ImGui::SameLine();
+        if (ImGui::SmallButton("x"))
+            remove = c;
+        if (open) {
+            std::size_t drop = curve.keys.size();
+            bool resort = false;
+            if (ImGui::BeginTable("##keys", 3, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+                ImGui::TableSetupColumn("Hour");
+                ImGui::TableSetupColumn("Value");
+                ImGui::TableSetupColumn("");
+                ImGui::TableHeadersRow();
+                for (std::size_t k = 0; k < curve.keys.size(); ++k) {
+                    auto &key = curve.keys[k];
+                    ImGui::PushID(static_cast<int>(k));
+                    ImGui::TableNextRow();
+                    ImGui::TableNextColumn();
+                    ImGui::InputFloat("##hour", &key.hour, 0.25f, 1.f, "%05.2f");
+                    resort |= ImGui::IsItemDeactivatedAfterEdit();
+                    ImGui::TableNextColumn();
+                    if (desc.ranged)
+                        ImGui::SliderFloat("##value", &key.value, desc.min, desc.max, desc.is_int ? "%.0f" : "%.3f");
+                    else
+                        ImGui::InputFloat("##value", &key.value);
+                    changed |= ImGui::IsItemDeactivatedAfterEdit();
+                    ImGui::TableNextColumn();
+                    if (ImGui::SmallButton("x"))
+                        drop = k;
+                    ImGui::PopID();
+                }
+                ImGui::EndTable();
+            }
+            if (drop < curve.keys.size()) {
+                curve.keys.erase(curve.keys.begin() + static_cast<std::ptrdiff_t>(drop));
+                changed = true;
+            }
+            if (ImGui::Button("Add key at current hour")) {
+                curve.keys.push_back({std::isnan(hour) ? 12.f : hour, current_value(curve.item)});
+                resort = true;
+            }
+            if (resort) {
+                normalize(curve);
+                changed = true;
+            }
+            ImGui::TreePop();
+        }
+        ImGui::PopID();
+    }
+    if (remove < gCurves.size()) {
+        gCurves.erase(gCurves.begin() + static_cast<std::ptrdiff_t>(remove));
+        changed = true;
+    }
+
+    static int pick = 0;
+    if (ImGui::BeginCombo("##add", kItems[static_cast<std::size_t>(pick)].key)) {
+        for (std::size_t i = 0; i < kItemCount; ++i)
+            if (ImGui::Selectable(kItems[i].key, static_cast<int>(i) == pick))
+                pick = static_cast<int>(i);
+        ImGui::EndCombo();
+    }
+    ImGui::SameLine();
+    const auto item = static_cast<std::size_t>(pick);
+    const bool exists = std::ranges::any_of(gCurves, [&](const tod_curve &curve) { return curve.item == item; });
+    ImGui::BeginDisabled(exists);
+    if (ImGui::Button("Add curve")) {
+        gCurves.push_back({item, true, {{std::isnan(hour) ? 12.f : hour, current_value(item)}}});
+        changed = true;
+    }
+    ImGui::EndDisabled();
+
+    if (changed) {
+        save_curves(runtime);
+        publish_overrides();
+    }
+}
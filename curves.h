@@ -0,0 +1,26 @@
+#pragma once
+
+namespace reshade::api {
+struct effect_runtime;
+}
+
+namespace SDK {
+struct FPostProcessSettings;
+}
+
+struct override_snapshot;
+
+// Time-of-day override curves: per-item keyframes (hour -> value), stored in the preset as
+// [untitled] Curves=Key=h:v,h:v,... and wrapping around midnight. The render thread flattens them into the override
+// snapshot; the camera update evaluates them against the world's clock, starting from each curve's last segment so a
+// steadily advancing clock costs a comparison or two per curve.
+
+void load_curves(reshade::api::effect_runtime *runtime);
+// copies the enabled curves into a snapshot about to be published (render thread)
+void fill_curves(override_snapshot &snapshot);
+// writes every curve's value at the current time of day on top of settings (game thread)
+void evaluate_curves(const override_snapshot &snapshot, SDK::FPostProcessSettings &settings);
+// the hour the last camera update evaluated against, NaN before the first one (any thread)
+float current_hour();
+
+void draw_curves(reshade::api::effect_runtime *runtime);
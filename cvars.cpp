@@ -0,0 +1,401 @@
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <future>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <imgui.h>
+#include <reshade.hpp>
+
+#include <easylogging++.h>
+
+#include <SDK/Engine_classes.hpp>
+
+#include "addon.h"
+#include "cvars.h"
+#include "tasks.h"
+
+// =========================
+// Entries (render thread)
+// =========================
+struct cvar_entry {
+    std::string name;
+    float value = 0.f;
+    bool enabled = true;
+    bool dirty = true;    // edited since last sent to the game thread
+    float current = NAN; // last value read back on the game thread
+    const char *status = "";
+};
+
+static std::vector<cvar_entry> gCVars;
+
+static bool same(float a, float b) { return std::fabs(a - b) <= 1e-6f * std::max(1.f, std::fabs(b)); }
+
+// =========================
+// Game-thread batches, time-sliced through the task queue
+// =========================
+static constexpr auto kSliceBudget = std::chrono::microseconds(250);
+
+struct cvar_command {
+    std::string name;
+    std::wstring wide; // cvar names are ASCII
+    float value;
+    bool revert = false; // put back the value seen before we first set it; value is unused
+};
+
+// Value each variable had before we first set it. Kept on the game thread, which reads it in the same slice that
+// issues the first write, so a revert queued behind that write always finds it, even before the overlay has heard
+// back from the batch. A revert forgets it, so the next first write captures whatever the game has by then.
+static std::unordered_map<std::string, float> gOriginals;
+
+struct cvar_result {
+    std::string name;
+    float requested;
+    float before;
+    float after;
+    bool issued;
+};
+
+struct cvar_report {
+    std::vector<cvar_result> results;
+    int slices = 0;
+    double ms = 0.0; // wall time from the first slice to the last
+};
+
+struct cvar_batch {
+    std::vector<cvar_command> commands;
+    std::size_t next = 0;
+    cvar_report report;
+    std::chrono::steady_clock::time_point first_slice;
+    std::promise<cvar_report> done;
+};
+
+// reads every variable and sets only those that differ, until the slice budget runs out; then yields the game thread
+// back to the engine and continues on the next drain
+static void run_slice(const std::shared_ptr<cvar_batch> &batch) {
+    using namespace std::chrono;
+    const auto start = steady_clock::now();
+    if (batch->report.slices++ == 0)
+        batch->first_slice = start;
+
+    auto world = SDK::UWorld::GetWorld();
+    while (world && batch->next < batch->commands.size()) {
+        const auto &command = batch->commands[batch->next++];
+        auto target = command.value;
+        if (command.revert) {
+            const auto original = gOriginals.find(command.name);
+            if (original == gOriginals.end())
+                continue; // never set by us
+            target = original->second;
+        }
+        const SDK::FString name(command.wide.c_str());
+        cvar_result result{command.name, target, 0.f, 0.f, false};
+        result.before = result.after = SDK::UKismetSystemLibrary::GetConsoleVariableFloatValue(name);
+        if (!same(result.before, target)) {
+            if (!command.revert)
+                gOriginals.try_emplace(command.name, result.before);
+            char value[32]{};
+            auto end = std::to_chars(std::begin(value), std::end(value) - 1, target).ptr;
+            const auto line = command.wide + L" " + std::wstring(value, end);
+            SDK::UKismetSystemLibrary::ExecuteConsoleCommand(world, SDK::FString(line.c_str()), nullptr);
+            result.after = SDK::UKismetSystemLibrary::GetConsoleVariableFloatValue(name);
+            result.issued = true;
+        }
+        if (command.revert)
+            gOriginals.erase(command.name);
+        batch->report.results.push_back(std::move(result));
+        if (steady_clock::now() - start >= kSliceBudget)
+            break;
+    }
+
+    if (batch->next < batch->commands.size()) {
+        EnqueueGameTask([batch] { run_slice(batch); });
+        return;
+    }
+    batch->report.ms = duration<double, std::milli>(steady_clock::now() - batch->first_slice).count();
+    batch->done.set_value(std::move(batch->report));
+}
+
+static std::future<cvar_report> gInFlight;
+static std::vector<cvar_command> gQueued; // submitted while a batch was in flight
+static std::size_t gLastChecked = 0;
+static std::size_t gLastIssued = 0;
+static std::size_t gLastRejected = 0;
+static int gLastSlices = 0;
+static double gLastMs = 0.0;
+
+static void submit(std::vector<cvar_command> commands) {
+    if (commands.empty())
+        return;
+    if (gInFlight.valid()) {
+        std::ranges::move(commands, std::back_inserter(gQueued));
+        return;
+    }
+    auto batch = std::make_shared<cvar_batch>();
+    batch->commands = std::move(commands);
+    gInFlight = batch->done.get_future();
+    EnqueueGameTask([batch] { run_slice(batch); });
+}
+
+static cvar_command make_command(const std::string &name, float value) {
+    return {name, std::wstring(name.begin(), name.end()), value};
+}
+static cvar_command make_revert(const std::string &name) {
+    return {name, std::wstring(name.begin(), name.end()), 0.f, true};
+}
+
+static cvar_entry *find(std::string_view name) {
+    auto it = std::ranges::find(gCVars, name, &cvar_entry::name);
+    return it == gCVars.end() ? nullptr : &*it;
+}
+
+void step_cvars() {
+    if (!gInFlight.valid() || gInFlight.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        return;
+    const auto report = gInFlight.get();
+    gLastChecked = report.results.size();
+    gLastIssued = gLastRejected = 0;
+    for (const auto &result : report.results) {
+        gLastIssued += result.issued;
+        const bool accepted = same(result.after, result.requested);
+        gLastRejected += !accepted;
+        if (!accepted)
+            LOG(WARNING) << "CVar " << result.name << " stayed at " << result.after << " (requested "
+                         << result.requested << "); unknown, read-only or clamped";
+        auto entry = find(result.name);
+        if (!entry)
+            continue;
+        entry->current = result.after;
+        entry->status = !accepted ? "rejected" : result.issued ? "set" : "unchanged";
+    }
+    gLastSlices = report.slices;
+    gLastMs = report.ms;
+    LOG(INFO) << "CVar batch: " << gLastChecked << " checked, " << gLastIssued << " set, " << gLastRejected
+              << " rejected in " << gLastSlices << " slices over " << gLastMs << " ms";
+    if (!gQueued.empty())
+        submit(std::exchange(gQueued, {}));
+}
+
+void apply_cvars() {
+    std::vector<cvar_command> commands;
+    for (auto &entry : gCVars) {
+        if (entry.enabled)
+            commands.push_back(make_command(entry.name, entry.value));
+        entry.dirty = false;
+    }
+    submit(std::move(commands));
+}
+
+void revert_cvars() {
+    std::vector<cvar_command> commands;
+    for (auto &entry : gCVars)
+        commands.push_back(make_revert(entry.name));
+    submit(std::move(commands));
+}
+
+// edited entries only; switching one off puts back its original value
+static void apply_dirty() {
+    std::vector<cvar_command> commands;
+    for (auto &entry : gCVars) {
+        if (!entry.dirty)
+            continue;
+        entry.dirty = false;
+        if (entry.enabled)
+            commands.push_back(make_command(entry.name, entry.value));
+        else
+            commands.push_back(make_revert(entry.name));
+    }
+    submit(std::move(commands));
+}
+
+// =========================
+// Preset storage: an array of "name=value", disabled entries prefixed with '#'
+// =========================
+static bool parse_entry(std::string_view text, cvar_entry &entry) {
+    entry.enabled = !text.starts_with('#');
+    if (!entry.enabled)
+        text.remove_prefix(1);
+    // "name=value" as stored, or "name value" as typed into the console / an ini [SystemSettings] line
+    const auto split = text.find_first_of("= \t");
+    if (split == std::string_view::npos || split == 0)
+        return false;
+    entry.name = std::string(text.substr(0, split));
+    auto value = text.substr(split + 1);
+    while (!value.empty() && (value.front() == ' ' || value.front() == '=' || value.front() == '\t'))
+        value.remove_prefix(1);
+    return std::from_chars(value.data(), value.data() + value.size(), entry.value).ec == std::errc();
+}
+
+static void save_cvars(reshade::api::effect_runtime *runtime) {
+    std::string packed;
+    for (const auto &entry : gCVars) {
+        if (!packed.empty())
+            packed.push_back('\0');
+        char value[32]{};
+        auto end = std::to_chars(std::begin(value), std::end(value), entry.value).ptr;
+        packed += (entry.enabled ? "" : "#") + entry.name + "=" + std::string(value, end);
+    }
+    reshade::set_config_value(runtime, kSection, "CVars", packed.c_str(), packed.size());
+}
+
+void load_cvars(reshade::api::effect_runtime *runtime) {
+    std::size_t size = 0;
+    std::string packed;
+    if (reshade::get_config_value(runtime, kSection, "CVars", nullptr, &size) && size > 0) {
+        packed.resize(size);
+        reshade::get_config_value(runtime, kSection, "CVars", packed.data(), &size);
+        packed.resize(size);
+    }
+
+    std::vector<cvar_entry> loaded;
+    for (std::size_t pos = 0; pos < packed.size();) {
+        auto end = packed.find('\0', pos);
+        if (end == std::string::npos)
+            end = packed.size();
+        if (cvar_entry entry; parse_entry(std::string_view(packed).substr(pos, end - pos), entry))
+            loaded.push_back(std::move(entry));
+        pos = end + 1;
+    }
+
+    // keep what we know about variables that survive the switch, and put back the ones that don't
+    std::vector<cvar_command> restore;
+    for (const auto &old : gCVars) {
+        auto it = std::ranges::find(loaded, old.name, &cvar_entry::name);
+        if (it != loaded.end())
+            it->current = old.current;
+        else
+            restore.push_back(make_revert(old.name));
+    }
+    gCVars = std::move(loaded);
+    submit(std::move(restore));
+    LOG(INFO) << "Loaded " << gCVars.size() << " CVar overrides";
+    if (gEnabled)
+        apply_cvars();
+    else
+        revert_cvars();
+}
+
+// =========================
+// Overlay panel
+// =========================
+void draw_cvars(reshade::api::effect_runtime *runtime) {
+    bool changed = false;
+
+    if (ImGui::Button("Re-apply all"))
+        apply_cvars();
+    if (ImGui::IsItemHovered())
+        ImGui::SetTooltip("Read every enabled variable back and set the ones the game changed since");
+    ImGui::SameLine();
+    if (ImGui::Button("Revert"))
+        revert_cvars();
+    ImGui::SameLine();
+    if (ImGui::Button("Import from clipboard")) {
+        // one variable per line; blank lines, ';' and '[' lines are skipped so ini snippets paste as-is
+        std::string_view text = ImGui::GetClipboardText() ? ImGui::GetClipboardText() : "";
+        std::size_t imported = 0;
+        while (!text.empty()) {
+            auto end = text.find_first_of("\r\n");
+            auto line = text.substr(0, end);
+            text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+            if (line.empty() || line.starts_with(';') || line.starts_with('['))
+                continue;
+            cvar_entry entry;
+            if (!parse_entry(line, entry))
+                continue;
+            if (auto existing = find(entry.name)) {
+                existing->value = entry.value;
+                existing->enabled = entry.enabled;
+                existing->dirty = true;
+            } else {
+                gCVars.push_back(std::move(entry));
+            }
+            ++imported;
+        }
+        LOG(INFO) << "Imported " << imported << " CVars from clipboard";
+        changed = true;
+    }
+
+    if (gInFlight.valid())
+        ImGui::TextDisabled("applying on the game thread...");
+    else if (gLastChecked)
+        ImGui::TextDisabled("last batch: %zu checked, %zu set, %zu rejected, %d slices over %.1f ms", gLastChecked,
+                            gLastIssued, gLastRejected, gLastSlices, gLastMs);
+
+    static char name[128]{};
+    static float value = 0.f;
+    ImGui::SetNextItemWidth(240);
+    ImGui::InputText("##name", name, sizeof(name));
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(100);
+    ImGui::InputFloat("##value", &value);
+    ImGui::SameLine();
+    if (ImGui::Button("Add") && name[0]) {
+        if (auto existing = find(name)) {
+            existing->value = value;
+            existing->dirty = true;
+        } else {
+            gCVars.push_back({.name = name, .value = value});
+        }
+        name[0] = '\0';
+        changed = true;
+    }
+
+    std::size_t remove = gCVars.size();
+    constexpr auto flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY;
+    if (!gCVars.empty() && ImGui::BeginTable("##cvars", 5, flags, ImVec2(0, 320))) {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("Variable");
+        ImGui::TableSetupColumn("Value");
+        ImGui::TableSetupColumn("Current");
+        ImGui::TableSetupColumn("Status");
+        ImGui::TableSetupColumn("");
+        ImGui::TableHeadersRow();
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(gCVars.size()));
+        while (clipper.Step()) {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+                auto &entry = gCVars[row];
+                ImGui::PushID(row);
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                if (ImGui::Checkbox("##enabled", &entry.enabled))
+                    entry.dirty = changed = true;
+                ImGui::SameLine();
+                ImGui::TextUnformatted(entry.name.c_str());
+                ImGui::TableNextColumn();
+                ImGui::InputFloat("##value", &entry.value);
+                if (ImGui::IsItemDeactivatedAfterEdit())
+                    entry.dirty = changed = true;
+                ImGui::TableNextColumn();
+                if (std::isnan(entry.current))
+                    ImGui::TextDisabled("?");
+                else
+                    ImGui::Text("%g", entry.current);
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(entry.status);
+                ImGui::TableNextColumn();
+                if (ImGui::SmallButton("x"))
+                    remove = static_cast<std::size_t>(row);
+                ImGui::PopID();
+            }
+        }
+        ImGui::EndTable();
+    }
+    if (remove < gCVars.size()) {
+        submit({make_revert(gCVars[remove].name)});
+        gCVars.erase(gCVars.begin() + static_cast<std::ptrdiff_t>(remove));
+        changed = true;
+    }
+
+    if (changed) {
+        save_cvars(runtime);
+        if (gEnabled)
+            apply_dirty();
+    }
+}
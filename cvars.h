@@ -0,0 +1,17 @@
+#pragma once
+
+namespace reshade::api {
+struct effect_runtime;
+}
+
+// Console-variable overrides stored in the preset next to the post-process ones ([untitled] CVars=name=value,...).
+// Batches run on the game thread in time slices; each variable is read back first and only set when it differs.
+
+void load_cvars(reshade::api::effect_runtime *runtime);
+// issues every enabled entry (verify + set), or restores the values seen before we first touched them
+void apply_cvars();
+void revert_cvars();
+// collects finished batches and starts a queued one; called from reshade_present
+void step_cvars();
+
+void draw_cvars(reshade::api::effect_runtime *runtime);
@@ -0,0 +1,158 @@
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include <imgui.h>
+
+#include <easylogging++.h>
+
+#include "addon.h"
+#include "delivery.h"
+
+std::atomic<DeliveryMode> GDeliveryMode = DeliveryMode::Modifier;
+std::atomic<uint64_t> GBlendCacheFallbacks = 0;
+
+namespace {
+
+constexpr const char *kModeNames[] = {"Camera modifier", "Blend cache"};
+
+// live cost per mode, moving average over camera updates (game thread writes, overlay reads)
+std::array<std::atomic<float>, 2> GCostNs{};
+
+// =========================
+// Benchmark: modes alternate in blocks of camera updates so drift in the scene weighs on both alike
+// =========================
+constexpr uint32_t kBenchmarkUpdates = 4000;
+constexpr uint32_t kBenchmarkBlock = 100;
+
+enum class BenchmarkState : int { Idle, Running, Done };
+std::atomic<BenchmarkState> GBenchmarkState = BenchmarkState::Idle;
+std::atomic<uint32_t> GBenchmarkUpdate = 0; // advanced by the game thread
+// owned by the game thread while Running, by the overlay otherwise
+std::array<std::vector<float>, 2> GSamplesNs;
+
+struct Summary {
+    std::size_t Count = 0;
+    double MeanUs = 0.0;
+    double P50Us = 0.0;
+    double P99Us = 0.0;
+};
+
+Summary Summarize(std::vector<float> samples) {
+    Summary summary{.Count = samples.size()};
+    if (samples.empty())
+        return summary;
+    std::ranges::sort(samples);
+    double total = 0.0;
+    for (const auto ns : samples)
+        total += ns;
+    summary.MeanUs = total / static_cast<double>(samples.size()) / 1000.0;
+    summary.P50Us = samples[samples.size() / 2] / 1000.0;
+    summary.P99Us = samples[std::min(samples.size() - 1, samples.size() * 99 / 100)] / 1000.0;
+    return summary;
+}
+
+} // namespace
+
+DeliveryMode DeliveryModeForUpdate() {
+    if (GBenchmarkState.load(std::memory_order_acquire) == BenchmarkState::Running)
+        return static_cast<DeliveryMode>(GBenchmarkUpdate.load(std::memory_order_relaxed) / kBenchmarkBlock % 2);
+    return GDeliveryMode.load(std::memory_order_relaxed);
+}
+
+void DeliveryRecord(DeliveryMode mode, std::chrono::steady_clock::time_point start) {
+    const auto ns = std::chrono::duration<float, std::nano>(std::chrono::steady_clock::now() - start).count();
+    auto &cost = GCostNs[static_cast<int>(mode)];
+    cost.store(cost.load(std::memory_order_relaxed) * 0.95f + ns * 0.05f, std::memory_order_relaxed);
+    if (GBenchmarkState.load(std::memory_order_relaxed) != BenchmarkState::Running)
+        return;
+    if (auto &samples = GSamplesNs[static_cast<int>(mode)]; samples.size() < samples.capacity())
+        samples.push_back(ns);
+    if (GBenchmarkUpdate.fetch_add(1, std::memory_order_relaxed) + 1 == 2 * kBenchmarkUpdates)
+        GBenchmarkState.store(BenchmarkState::Done, std::memory_order_release);
+}
+
+// =========================
+// Overlay panel
+// =========================
+void DrawDelivery() {
+    static std::array<Summary, 2> results;
+
+    auto mode = static_cast<int>(GDeliveryMode.load(std::memory_order_relaxed));
+    const auto state = GBenchmarkState.load(std::memory_order_acquire);
+    ImGui::BeginDisabled(state == BenchmarkState::Running);
+    bool changed = ImGui::RadioButton(kModeNames[0], &mode, 0);
+    ImGui::SameLine();
+    changed |= ImGui::RadioButton(kModeNames[1], &mode, 1);
+    ImGui::EndDisabled();
+    if (ImGui::IsItemHovered(ImGuiHoveredFlags_AllowWhenDisabled))
+        ImGui::SetTooltip("Write overrides straight into the camera's post-process blend cache, skipping the "
+                          "BlueprintModifyPostProcess dispatch");
+    if (changed) {
+        GDeliveryMode.store(static_cast<DeliveryMode>(mode), std::memory_order_relaxed);
+        LOG(INFO) << "Override delivery: " << kModeNames[mode];
+    }
+    ImGui::TextDisabled("Per camera update: %.2f us (modifier), %.2f us (blend cache); %llu blend-cache fallbacks",
+                        GCostNs[0].load(std::memory_order_relaxed) / 1000.f,
+                        GCostNs[1].load(std::memory_order_relaxed) / 1000.f,
+                        static_cast<unsigned long long>(GBlendCacheFallbacks.load(std::memory_order_relaxed)));
+
+    if (state == BenchmarkState::Running) {
+        ImGui::Text("Benchmarking... %u / %u camera updates", GBenchmarkUpdate.load(std::memory_order_relaxed),
+                    2 * kBenchmarkUpdates);
+        return;
+    }
+    if (state == BenchmarkState::Done) {
+        for (int m = 0; m < 2; ++m) {
+            results[m] = Summarize(GSamplesNs[m]);
+            LOG(INFO) << "Delivery benchmark, " << kModeNames[m] << ": " << results[m].Count << " updates, mean "
+                      << results[m].MeanUs << " us, p50 " << results[m].P50Us << " us, p99 " << results[m].P99Us
+                      << " us";
+        }
+        GBenchmarkState.store(BenchmarkState::Idle, std::memory_order_relaxed);
+    }
+
+    ImGui::BeginDisabled(!gEnabled);
+    if (ImGui::Button("Benchmark")) {
+        for (auto &samples : GSamplesNs) {
+            samples.clear();
+            samples.reserve(2 * kBenchmarkUpdates); // the game thread never allocates; fallbacks land in Modifier
+        }
+        GBenchmarkUpdate.store(0, std::memory_order_relaxed);
+        GBenchmarkState.store(BenchmarkState::Running, std::memory_order_release);
+        LOG(INFO) << "Delivery benchmark started";
+    }
+    ImGui::EndDisabled();
+    if (ImGui::IsItemHovered(ImGuiHoveredFlags_AllowWhenDisabled))
+        ImGui::SetTooltip("Alternates both modes every %u camera updates, %u updates each. Needs the global gate on.\n"
+                          "Modifier mode also pays the engine's AddCachedPPBlend copy, which happens outside the "
+                          "hook and is not in its numbers.",
+                          kBenchmarkBlock, kBenchmarkUpdates);
+
+    if (results[0].Count == 0 && results[1].Count == 0)
+        return;
+    if (ImGui::BeginTable("##delivery", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+        ImGui::TableSetupColumn("Mode");
+        ImGui::TableSetupColumn("Updates");
+        ImGui::TableSetupColumn("Mean us");
+        ImGui::TableSetupColumn("p50 us");
+        ImGui::TableSetupColumn("p99 us");
+        ImGui::TableHeadersRow();
+        for (int m = 0; m < 2; ++m) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(kModeNames[m]);
+            ImGui::TableNextColumn();
+            ImGui::Text("%zu", results[m].Count);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.2f", results[m].MeanUs);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.2f", results[m].P50Us);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.2f", results[m].P99Us);
+        }
+        ImGui::EndTable();
+    }
+    if (results[0].MeanUs > 0.0 && results[1].Count > 0)
+        ImGui::Text("Blend cache: %.0f%% of the modifier's mean cost", 100.0 * results[1].MeanUs / results[0].MeanUs);
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+// How the override snapshot reaches the view each camera update.
+//  Modifier:   our UCameraModifier's BlueprintModifyPostProcess is dispatched, we fill its params, and the engine
+//              copies them into APlayerCameraManager::PostProcessBlendCache through AddCachedPPBlend.
+//  BlendCache: the dispatch is skipped and the snapshot is written straight into a new blend-cache entry. Falls back
+//              to Modifier for an update whenever the cache has no spare capacity.
+enum class DeliveryMode : int { Modifier = 0, BlendCache = 1 };
+extern std::atomic<DeliveryMode> GDeliveryMode;
+extern std::atomic<uint64_t> GBlendCacheFallbacks;
+
+// the mode this camera update should use; the benchmark alternates it (game thread)
+extern DeliveryMode DeliveryModeForUpdate();
+// one delivery's cost from the hook's point of view, started before the mode's work (game thread)
+extern void DeliveryRecord(DeliveryMode mode, std::chrono::steady_clock::time_point start);
+extern void DrawDelivery();
@@ -0,0 +1,166 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cfloat>
+#include <chrono>
+#include <unordered_map>
+#include <utility>
+
+#include <imgui.h>
+
+#include "frames.h"
+
+// =========================
+// Lock-free SPSC ring of frame samples (producer: reshade_present, consumers: overlay and benchmarks)
+// =========================
+static constexpr std::size_t kRingSize = 8192; // power of two; a bit over 2 minutes at 60 fps
+
+struct ring_entry {
+    std::atomic<int64_t> end_ns;
+    std::atomic<float> ms;
+    std::atomic<uint32_t> tag;
+};
+
+static std::array<ring_entry, kRingSize> gRing{};
+static std::atomic<uint64_t> gHead = 0;
+static std::atomic<uint32_t> gTag = 0;
+static std::atomic<uint64_t> gHitches = 0;
+
+// producer-only state; the overlay runs on the same render thread, so the hitch knobs need no atomics
+static int64_t gLastPresent = 0;
+static float gSmoothedMs = 0.f; // EWMA baseline for hitch detection
+static float gHitchFactor = 2.0f;
+static float gHitchMinMs = 25.0f;
+
+static int64_t now_ns() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+void record_frame() {
+    const auto now = now_ns();
+    const auto last = std::exchange(gLastPresent, now);
+    if (last == 0)
+        return;
+    const float ms = static_cast<float>(now - last) / 1e6f;
+
+    if (gSmoothedMs > 0.f && ms > gHitchMinMs && ms > gHitchFactor * gSmoothedMs)
+        gHitches.fetch_add(1, std::memory_order_relaxed);
+    gSmoothedMs = gSmoothedMs == 0.f ? ms : gSmoothedMs + 0.05f * (ms - gSmoothedMs);
+
+    const auto head = gHead.load(std::memory_order_relaxed);
+    auto &entry = gRing[head & (kRingSize - 1)];
+    entry.end_ns.store(now, std::memory_order_relaxed);
+    entry.ms.store(ms, std::memory_order_relaxed);
+    entry.tag.store(gTag.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    gHead.store(head + 1, std::memory_order_release);
+}
+
+void set_frame_tag(uint32_t tag) { gTag.store(tag, std::memory_order_relaxed); }
+uint32_t frame_tag() { return gTag.load(std::memory_order_relaxed); }
+uint64_t frame_count() { return gHead.load(std::memory_order_acquire); }
+
+uint64_t copy_frames(uint64_t first, std::vector<frame_sample> &out) {
+    const auto head = gHead.load(std::memory_order_acquire);
+    // the producer overwrites slot head - kRingSize before it publishes head + 1, so that one may be mid-write
+    first = std::max(first, head >= kRingSize ? head - kRingSize + 1 : 0);
+    out.clear();
+    if (first >= head)
+        return head;
+    out.reserve(static_cast<std::size_t>(head - first));
+    for (auto i = first; i < head; ++i) {
+        const auto &entry = gRing[i & (kRingSize - 1)];
+        out.push_back({entry.end_ns.load(std::memory_order_relaxed), entry.ms.load(std::memory_order_relaxed),
+                       entry.tag.load(std::memory_order_relaxed)});
+    }
+    // drop whatever the producer lapped while we were copying
+    const auto after = gHead.load(std::memory_order_acquire);
+    if (after >= kRingSize && after - kRingSize + 1 > first) {
+        const auto lapped = std::min<std::size_t>(out.size(), static_cast<std::size_t>(after - kRingSize + 1 - first));
+        out.erase(out.begin(), out.begin() + static_cast<std::ptrdiff_t>(lapped));
+        first += lapped;
+    }
+    return first;
+}
+
+float frame_percentile(std::vector<float> &ms, float q) {
+    if (ms.empty())
+        return 0.f;
+    const auto rank = static_cast<std::size_t>(q * static_cast<float>(ms.size() - 1) + 0.5f);
+    const auto nth = ms.begin() + static_cast<std::ptrdiff_t>(std::min(rank, ms.size() - 1));
+    std::nth_element(ms.begin(), nth, ms.end());
+    return *nth;
+}
+
+// =========================
+// Overlay panel
+// =========================
+void draw_frame_stats() {
+    static int window = 600;
+    static std::vector<frame_sample> samples;
+    static std::vector<float> ms;
+    static std::unordered_map<uint32_t, std::vector<float>> by_tag;
+
+    ImGui::SliderInt("Window (frames)", &window, 60, static_cast<int>(kRingSize));
+    const auto count = frame_count();
+    copy_frames(count > static_cast<uint64_t>(window) ? count - window : 0, samples);
+    if (samples.empty()) {
+        ImGui::TextDisabled("no frames yet");
+        return;
+    }
+
+    ms.clear();
+    for (const auto &sample : samples)
+        ms.push_back(sample.ms);
+    const auto spark_len = std::min<std::size_t>(ms.size(), 240);
+    ImGui::PlotLines("##sparkline", ms.data() + (ms.size() - spark_len), static_cast<int>(spark_len), 0, nullptr, 0.f,
+                     FLT_MAX, ImVec2(0, 60));
+
+    double total = 0.0;
+    for (auto v : ms)
+        total += v;
+    const auto mean = total / static_cast<double>(ms.size());
+    const auto p50 = frame_percentile(ms, 0.50f);
+    const auto p95 = frame_percentile(ms, 0.95f);
+    const auto p99 = frame_percentile(ms, 0.99f);
+    ImGui::Text("p50 %.2f ms | p95 %.2f ms | p99 %.2f ms | %.1f fps", p50, p95, p99, mean > 0.0 ? 1000.0 / mean : 0.0);
+
+    ImGui::Text("Hitches: %llu", static_cast<unsigned long long>(gHitches.load(std::memory_order_relaxed)));
+    ImGui::SameLine();
+    if (ImGui::SmallButton("Reset##hitches"))
+        gHitches.store(0, std::memory_order_relaxed);
+    ImGui::SliderFloat("Hitch factor", &gHitchFactor, 1.25f, 5.0f, "%.2fx");
+    if (ImGui::IsItemHovered())
+        ImGui::SetTooltip("A frame counts as a hitch when it is this many times slower than the running average");
+    ImGui::SliderFloat("Hitch minimum", &gHitchMinMs, 5.0f, 200.0f, "%.1f ms");
+
+    // attribute the window to the override sets that were active
+    for (auto &[tag, values] : by_tag)
+        values.clear();
+    for (const auto &sample : samples)
+        by_tag[sample.tag].push_back(sample.ms);
+    std::erase_if(by_tag, [](const auto &entry) { return entry.second.empty(); });
+    const auto current = frame_tag();
+    if (ImGui::BeginTable("##by_tag", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+        ImGui::TableSetupColumn("Override set");
+        ImGui::TableSetupColumn("Frames");
+        ImGui::TableSetupColumn("p50 ms");
+        ImGui::TableSetupColumn("p95 ms");
+        ImGui::TableSetupColumn("p99 ms");
+        ImGui::TableHeadersRow();
+        for (auto &[tag, values] : by_tag) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::Text("%08X%s", tag, tag == current ? " (active)" : "");
+            ImGui::TableNextColumn();
+            ImGui::Text("%zu", values.size());
+            ImGui::TableNextColumn();
+            ImGui::Text("%.2f", frame_percentile(values, 0.50f));
+            ImGui::TableNextColumn();
+            ImGui::Text("%.2f", frame_percentile(values, 0.95f));
+            ImGui::TableNextColumn();
+            ImGui::Text("%.2f", frame_percentile(values, 0.99f));
+        }
+        ImGui::EndTable();
+    }
+}
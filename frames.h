@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// one presented frame; tag is the hash of the override set that was active when it ended
+struct frame_sample {
+    int64_t end_ns; // steady_clock
+    float ms;
+    uint32_t tag;
+};
+
+// fed from reshade_present (render thread)
+void record_frame();
+// override-set hash applied to subsequent samples
+void set_frame_tag(uint32_t tag);
+uint32_t frame_tag();
+
+// total frames recorded so far; also the index one past the newest sample
+uint64_t frame_count();
+// copies samples with index in [first, frame_count()) that are still in the ring; returns the index of out[0]
+uint64_t copy_frames(uint64_t first, std::vector<frame_sample> &out);
+// percentile over a sorted-in-place copy of ms values, q in [0, 1]
+float frame_percentile(std::vector<float> &ms, float q);
+
+void draw_frame_stats();
@@ -0,0 +1,334 @@
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <imgui.h>
+#include <reshade.hpp>
+
+#include <easylogging++.h>
+
+#include "abtest.h"
+#include "addon.h"
+#include "frames.h"
+#include "governor.h"
+#include "mixer.h"
+#include "sweep.h"
+
+// =========================
+// Ladder and knobs
+// =========================
+struct rung {
+    std::size_t item;
+    float value;                // the cheaper value this rung applies
+    bool saved_enabled = false; // user state restored when stepping back up
+    Value saved_value{};
+    float saving_ms = NAN; // measured effect of the last step down onto this rung
+    bool passed = false;   // applied as a no-op because the user's own value was already cheaper
+};
+
+static bool gGovernorEnabled = false;
+static float gTargetMs = 1000.f / 60.f;
+static float gBand = 0.05f;     // over target + band: step down
+static float gHeadroom = 0.15f; // under target - headroom: consider stepping up
+static int gSettle = 10;        // frames dropped after every step
+static int gWindow = 30;        // frames measured per decision
+static std::vector<rung> gLadder;
+
+// defaults: the overrides with the most direct GPU cost, cheapest-to-lose first
+static std::vector<rung> default_ladder() {
+    std::vector<rung> ladder;
+    auto add = [&](const char *key, float value) {
+        if (auto item = find_item(key); item < kItemCount)
+            ladder.push_back({item, value});
+    };
+    add("LensFlareBokehSize", 0.f);
+    add("MotionBlurPerObjectSize", 10.f);
+    add("BloomMethod", 0.f);
+    add("ScreenSpaceReflectionQuality", 25.f);
+    add("LumenReflectionQuality", 0.5f);
+    add("LumenFinalGatherQuality", 0.5f);
+    return ladder;
+}
+
+// =========================
+// Controller state (render thread)
+// =========================
+static std::size_t gLevel = 0; // rungs currently applied
+static uint64_t gWindowStart = 0;
+static float gMeasuredMs = NAN;
+static float gBeforeStepMs = NAN; // measurement that triggered the pending step, to log its effect
+static int gPendingStep = 0;      // -1 down, +1 up, 0 none
+static std::deque<std::string> gLog;
+static std::vector<frame_sample> gScratch;
+static std::vector<float> gMs;
+
+static void note(std::string line) {
+    LOG(INFO) << "Governor: " << line;
+    gLog.push_back(std::move(line));
+    if (gLog.size() > 8)
+        gLog.pop_front();
+}
+
+static std::string describe(const rung &r) {
+    char value[32]{};
+    auto end = std::to_chars(std::begin(value), std::end(value), r.value).ptr;
+    return std::string(kItems[r.item].key) + "=" + std::string(value, end);
+}
+
+// rung values are the cheap end of their item, so an enabled override at or below one already costs less
+static bool already_cheaper(const rung &r) {
+    if (!gEnables[r.item])
+        return false;
+    const auto value =
+        kItems[r.item].is_int ? static_cast<float>(gValues[r.item].get<int>()) : gValues[r.item].get<float>();
+    return value <= r.value;
+}
+
+static void step_down() {
+    auto &r = gLadder[gLevel++];
+    r.saved_enabled = gEnables[r.item];
+    r.saved_value = gValues[r.item];
+    r.passed = already_cheaper(r);
+    if (r.passed)
+        return;
+    gEnables[r.item] = true;
+    if (kItems[r.item].is_int)
+        gValues[r.item] = static_cast<int>(std::lround(r.value));
+    else
+        gValues[r.item] = r.value;
+    apply_overrides();
+}
+
+static void step_up() {
+    const auto &r = gLadder[--gLevel];
+    if (r.passed)
+        return;
+    gEnables[r.item] = r.saved_enabled;
+    gValues[r.item] = r.saved_value;
+    apply_overrides();
+}
+
+static void restore_all() {
+    if (gLevel == 0)
+        return;
+    while (gLevel > 0)
+        step_up();
+    gPendingStep = 0;
+    note("restored user settings");
+}
+
+void reset_governor() {
+    gLevel = 0;
+    gPendingStep = 0;
+    gWindowStart = frame_count();
+}
+
+void step_governor() {
+    // checked first: the A/B test flips the gate per arm, which must not read as the governor being switched off
+    if (ab_test_running() || sweep_running() || mixer_running()) {
+        // the test, sweep or mix owns the override state and frame times; start over once it hands them back. A mix
+        // rewrites the held items on every remix, but puts back the arrays it found, rungs included, when it stops.
+        gWindowStart = frame_count();
+        return;
+    }
+    if (!gGovernorEnabled || !gEnabled) {
+        restore_all();
+        return;
+    }
+    const auto begin = gWindowStart + static_cast<uint64_t>(gSettle);
+    const auto end = begin + static_cast<uint64_t>(gWindow);
+    if (frame_count() < end)
+        return;
+
+    // median over the window: robust to the odd hitch, which is not what the ladder can fix
+    const auto first = copy_frames(begin, gScratch);
+    gMs.clear();
+    for (std::size_t i = 0; i < gScratch.size() && first + i < end; ++i)
+        gMs.push_back(gScratch[i].ms);
+    gWindowStart = frame_count();
+    if (gMs.empty())
+        return;
+    gMeasuredMs = frame_percentile(gMs, 0.5f);
+
+    if (gPendingStep != 0) {
+        const auto effect = gMeasuredMs - gBeforeStepMs;
+        if (gPendingStep < 0)
+            gLadder[gLevel - 1].saving_ms = -effect;
+        note("level " + std::to_string(gLevel) + ": " + std::to_string(gBeforeStepMs) + " -> " +
+             std::to_string(gMeasuredMs) + " ms (" + (effect <= 0.f ? "" : "+") + std::to_string(effect) + " ms)");
+        gPendingStep = 0;
+    }
+
+    const auto over = gTargetMs * (1.f + gBand);
+    const auto under = gTargetMs * (1.f - gHeadroom);
+    if (gMeasuredMs > over && gLevel < gLadder.size()) {
+        // forcing a rung the user already undercuts would raise the cost; pass over it and step onto the next one
+        while (gLevel < gLadder.size() && already_cheaper(gLadder[gLevel])) {
+            note("passing " + describe(gLadder[gLevel]) + ", already cheaper");
+            step_down();
+        }
+        if (gLevel == gLadder.size())
+            return;
+        gBeforeStepMs = gMeasuredMs;
+        gPendingStep = -1;
+        note("over target at " + std::to_string(gMeasuredMs) + " ms, applying " + describe(gLadder[gLevel]));
+        step_down();
+    } else if (gMeasuredMs < under && gLevel > 0) {
+        // passed rungs changed nothing, so there is nothing to give back on them
+        while (gLevel > 0 && gLadder[gLevel - 1].passed)
+            step_up();
+        if (gLevel == 0)
+            return;
+        // hysteresis: only give a rung back if what it cost last time still fits under the target
+        const auto &r = gLadder[gLevel - 1];
+        const auto predicted = gMeasuredMs + (std::isnan(r.saving_ms) ? 0.f : std::max(r.saving_ms, 0.f));
+        if (predicted <= over) {
+            gBeforeStepMs = gMeasuredMs;
+            gPendingStep = +1;
+            note("headroom at " + std::to_string(gMeasuredMs) + " ms, releasing " + describe(r));
+            step_up();
+        }
+    }
+}
+
+// =========================
+// Preset storage
+// =========================
+static void save_governor(reshade::api::effect_runtime *runtime) {
+    reshade::set_config_value(runtime, kSection, "Governor.Enabled", gGovernorEnabled ? "1" : "0");
+    char buf[32]{};
+    auto end = std::to_chars(std::begin(buf), std::end(buf), gTargetMs).ptr;
+    reshade::set_config_value(runtime, kSection, "Governor.TargetMs", buf, static_cast<std::size_t>(end - buf));
+    std::string packed;
+    for (const auto &r : gLadder) {
+        if (!packed.empty())
+            packed.push_back('\0');
+        packed += describe(r);
+    }
+    reshade::set_config_value(runtime, kSection, "Governor.Ladder", packed.c_str(), packed.size());
+}
+
+void load_governor(reshade::api::effect_runtime *runtime) {
+    reset_governor();
+    char buf[64]{};
+    std::size_t size = sizeof(buf);
+    gGovernorEnabled = reshade::get_config_value(runtime, kSection, "Governor.Enabled", buf, &size) && size > 0 &&
+                       buf[0] == '1';
+    if (size = sizeof(buf); reshade::get_config_value(runtime, kSection, "Governor.TargetMs", buf, &size) && size > 1)
+        std::from_chars(buf, buf + size - 1, gTargetMs);
+
+    std::string packed;
+    if (size = 0; reshade::get_config_value(runtime, kSection, "Governor.Ladder", nullptr, &size) && size > 0) {
+        packed.resize(size);
+        reshade::get_config_value(runtime, kSection, "Governor.Ladder", packed.data(), &size);
+        packed.resize(size);
+        gLadder.clear();
+        for (std::size_t pos = 0; pos < packed.size();) {
+            auto stop = packed.find('\0', pos);
+            if (stop == std::string::npos)
+                stop = packed.size();
+            const auto entry = std::string_view(packed).substr(pos, stop - pos);
+            const auto eq = entry.find('=');
+            float value = 0.f;
+            if (eq != std::string_view::npos &&
+                std::from_chars(entry.data() + eq + 1, entry.data() + entry.size(), value).ec == std::errc())
+                if (auto item = find_item(entry.substr(0, eq)); item < kItemCount)
+                    gLadder.push_back({item, value});
+            pos = stop + 1;
+        }
+    } else {
+        gLadder = default_ladder();
+    }
+}
+
+// =========================
+// Overlay panel
+// =========================
+void draw_governor(reshade::api::effect_runtime *runtime) {
+    bool changed = ImGui::Checkbox("Enabled##governor", &gGovernorEnabled);
+    ImGui::SameLine();
+    ImGui::TextDisabled("level %zu/%zu, median %.2f ms", gLevel, gLadder.size(), gMeasuredMs);
+    ImGui::SliderFloat("Target", &gTargetMs, 4.f, 50.f, "%.2f ms");
+    changed |= ImGui::IsItemDeactivatedAfterEdit();
+    ImGui::SameLine();
+    ImGui::TextDisabled("(%.0f fps)", 1000.f / gTargetMs);
+    ImGui::SliderFloat("Band", &gBand, 0.01f, 0.25f, "+%.2f");
+    ImGui::SliderFloat("Headroom", &gHeadroom, 0.05f, 0.5f, "-%.2f");
+    ImGui::SliderInt("Window (frames)", &gWindow, 10, 240);
+    ImGui::SliderInt("Settle (frames)", &gSettle, 0, 120);
+
+    // the ladder is frozen while rungs are applied, so saved user values always match their rung
+    ImGui::BeginDisabled(gLevel > 0);
+    std::size_t remove = gLadder.size();
+    std::size_t raise = gLadder.size();
+    if (ImGui::BeginTable("##ladder", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+        ImGui::TableSetupColumn("Override");
+        ImGui::TableSetupColumn("Cheaper value");
+        ImGui::TableSetupColumn("Saved ms");
+        ImGui::TableSetupColumn("");
+        ImGui::TableHeadersRow();
+        for (std::size_t i = 0; i < gLadder.size(); ++i) {
+            auto &r = gLadder[i];
+            ImGui::PushID(static_cast<int>(i));
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::Text("%zu. %s%s", i + 1, kItems[r.item].key,
+                        i >= gLevel ? "" : r.passed ? " (already cheaper)" : " (applied)");
+            ImGui::TableNextColumn();
+            ImGui::InputFloat("##value", &r.value);
+            changed |= ImGui::IsItemDeactivatedAfterEdit();
+            ImGui::TableNextColumn();
+            if (std::isnan(r.saving_ms))
+                ImGui::TextDisabled("?");
+            else
+                ImGui::Text("%.2f", r.saving_ms);
+            ImGui::TableNextColumn();
+            if (i > 0 && ImGui::SmallButton("up"))
+                raise = i;
+            ImGui::SameLine();
+            if (ImGui::SmallButton("x"))
+                remove = i;
+            ImGui::PopID();
+        }
+        ImGui::EndTable();
+    }
+    if (raise < gLadder.size()) {
+        std::swap(gLadder[raise - 1], gLadder[raise]);
+        changed = true;
+    }
+    if (remove < gLadder.size()) {
+        gLadder.erase(gLadder.begin() + static_cast<std::ptrdiff_t>(remove));
+        changed = true;
+    }
+
+    static int pick = 0;
+    if (ImGui::BeginCombo("##add", kItems[static_cast<std::size_t>(pick)].key)) {
+        for (std::size_t i = 0; i < kItemCount; ++i)
+            if (ImGui::Selectable(kItems[i].key, static_cast<int>(i) == pick))
+                pick = static_cast<int>(i);
+        ImGui::EndCombo();
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Add rung")) {
+        const auto item = static_cast<std::size_t>(pick);
+        gLadder.push_back({item, kItems[item].ranged ? kItems[item].min : 0.f});
+        changed = true;
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Defaults")) {
+        gLadder = default_ladder();
+        changed = true;
+    }
+    ImGui::EndDisabled();
+
+    for (const auto &line : gLog)
+        ImGui::TextDisabled("%s", line.c_str());
+
+    if (changed)
+        save_governor(runtime);
+}
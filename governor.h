@@ -0,0 +1,17 @@
+#pragma once
+
+namespace reshade::api {
+struct effect_runtime;
+}
+
+// Closed-loop frame-time governor: walks a user-ordered ladder of cheaper override values down while frames run over
+// the target and back up when there is headroom. Runs on the render thread off the frame collector and applies
+// through the same override arrays as the overlay, so the game thread only ever sees a changed settings struct.
+
+void load_governor(reshade::api::effect_runtime *runtime);
+// called from reshade_present right after record_frame()
+void step_governor();
+// forgets the applied rungs without restoring them, for when a preset load replaces the override state
+void reset_governor();
+
+void draw_governor(reshade::api::effect_runtime *runtime);
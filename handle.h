@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <SDK/CoreUObject_classes.hpp>
+
+// (index, serial) reference to a UObject, checked the way TWeakObjectPtr is: the GObjects slot must still hold the
+// same object and, once the engine has numbered the slot, the same serial. The SDK's FWeakObjectPtr::Get() only looks
+// at the index, which a level transition happily hands to something else.
+struct ObjectHandle {
+    // FUObjectItem::SerialNumber on UE5 (after Object, Flags and ClusterRootIndex), inside the SDK's padding
+    static constexpr std::size_t kSerialOffset = 0x10;
+
+    SDK::UObject *Object = nullptr;
+    int32_t Index = -1;
+    int32_t Serial = 0; // 0 until something asked the engine for a weak pointer; then only the slot is compared
+
+    static const SDK::FUObjectItem *Item(int32_t index) {
+        auto objects = SDK::UObject::GObjects.operator->();
+        const auto chunk = index / SDK::TUObjectArray::ElementsPerChunk;
+        if (index < 0 || index >= objects->NumElements || chunk >= objects->NumChunks)
+            return nullptr;
+        auto items = objects->GetDecrytedObjPtr()[chunk];
+        return items ? &items[index % SDK::TUObjectArray::ElementsPerChunk] : nullptr;
+    }
+
+    static int32_t SerialOf(const SDK::FUObjectItem &item) {
+        int32_t serial;
+        std::memcpy(&serial, reinterpret_cast<const std::byte *>(&item) + kSerialOffset, sizeof(serial));
+        return serial;
+    }
+
+    static ObjectHandle Of(SDK::UObject *object) {
+        if (!object)
+            return {};
+        auto item = Item(object->Index);
+        return {object, object->Index, item ? SerialOf(*item) : 0};
+    }
+
+    // nullptr once the slot was freed or reused
+    SDK::UObject *Get() const {
+        auto item = Object ? Item(Index) : nullptr;
+        if (!item || item->Object != Object || (Serial != 0 && SerialOf(*item) != Serial))
+            return nullptr;
+        return Object;
+    }
+    template <typename T> T *Get() const { return static_cast<T *>(Get()); }
+};
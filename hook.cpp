@@ -1,10 +1,15 @@
+#include <array>
 #include <atomic>
+#include <bit>
 #include <chrono>
+#include <condition_variable>
 #include <filesystem>
 #include <mutex>
 #include <shared_mutex>
 #include <thread>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 #include <windows.h>
 
 #include <MinHook.h>
@@ -15,8 +20,20 @@
 #include <SDK/OakGame_classes.hpp>
 
 #include "addon.h"
+#include "census.h"
+#include "curves.h"
+#include "delivery.h"
 #include "fields.h"
+#include "handle.h"
 #include "hook.h"
+#include "layout.h"
+#include "profiler.h"
+#include "reflect.h"
+#include "streaming.h"
+#include "tasks.h"
+#include "ticks.h"
+#include "view.h"
+#include "zones.h"
 
 namespace SDK {
 
@@ -28,14 +45,7 @@ inline FPostProcessSettings &operator|=(FPostProcessSettings &lhs, const FPostPr
     }
     FOR_EACH(ASSIGN_FIELD, PPS_FIELDS);
 #undef ASSIGN_FIELD
-#define ASSIGN_GBX_FIELD(Gbx, Name)                                                                                    \
-    {                                                                                                                  \
-        lhs.bShow##Gbx = rhs.bShow##Gbx;                                                                               \
-        lhs.Gbx.bOverride_##Name = rhs.Gbx.bOverride_##Name;                                                           \
-        lhs.Gbx.Name = rhs.Gbx.Name;                                                                                   \
-    }
-    FOR_EACH(ASSIGN_GBX_FIELD, GBX_PPS_TUPLES);
-#undef ASSIGN_GBX_FIELD
+    // the Gbx sub-structs go through MergeGbxBlocks
     return lhs;
 }
 
@@ -66,7 +76,25 @@ std::mutex GMutex;
 ProcessEvent GProcessEvent = nullptr;
 
 set<std::string> GFunctionNames;
-std::atomic<std::pair<SDK::UCameraModifier *, SDK::UFunction *> *> MyCameraModifier = nullptr;
+struct MyModifier {
+    SDK::UCameraModifier *Modifier;
+    SDK::UFunction *ModifyPostProcess;
+    SDK::UFunction *ModifyCamera;
+    ObjectHandle ModifierHandle;
+    ObjectHandle CameraHandle;
+};
+// two slots used in turn, so a thread still holding the previous one never sees it rewritten under it
+std::array<MyModifier, 2> GModifierSlots{};
+std::size_t GModifierSlot = 0;
+// null while discovery is armed: the slow path in MyProcessEvent looks for a camera manager to install on
+std::atomic<MyModifier *> MyCameraModifier = nullptr;
+// camera updates that went through our modifier; the render-thread watchdog asks for a check once it stops moving
+std::atomic<uint64_t> GModifierCalls = 0;
+constexpr int kStalePresents = 3;
+// set by the watchdog, cleared by the game thread once it has checked whether our modifier and its camera still live
+std::atomic_bool GModifierSuspect = false;
+// set by BlueprintModifyCamera so the BlueprintModifyPostProcess right after it uses the same snapshot (game thread)
+bool GSnapshotPinned = false;
 std::atomic_bool GUninstalling = false;
 
 void *GetProcessEvent(SDK::UEngine *engine) {
@@ -74,32 +102,221 @@ void *GetProcessEvent(SDK::UEngine *engine) {
     return vtable[SDK::Offsets::ProcessEventIdx];
 }
 
+// readiness: exponential backoff from microseconds up, cut short by NotifyEngineMaybeReady()
+constexpr auto kBackoffMin = std::chrono::microseconds(50);
+constexpr auto kBackoffMax = std::chrono::microseconds(100'000);
+
+std::mutex GReadyMutex;
+std::condition_variable GReadyCondition;
+bool GReadyPoked = false;
+std::chrono::steady_clock::time_point GInstallStart;
+
+int64_t MicrosecondsSinceInstall() {
+    using namespace std::chrono;
+    return duration_cast<microseconds>(steady_clock::now() - GInstallStart).count();
+}
+
+// waits for the current delay and doubles it; a poke ends the wait early and restarts from the minimum
+void Backoff(std::chrono::microseconds &delay) {
+    const auto deadline = std::chrono::steady_clock::now() + delay;
+    if (delay < std::chrono::milliseconds(1)) {
+        // below the scheduler tick a sleep overshoots by whole milliseconds, so yield instead
+        while (std::chrono::steady_clock::now() < deadline)
+            std::this_thread::yield();
+        delay *= 2;
+        return;
+    }
+    std::unique_lock lock(GReadyMutex);
+    if (GReadyCondition.wait_until(lock, deadline, [] { return GReadyPoked; })) {
+        GReadyPoked = false;
+        delay = kBackoffMin;
+        return;
+    }
+    delay = std::min(delay * 2, kBackoffMax);
+}
+
 void WaitForReady() {
-    while (!SDK::UEngine::GetEngine()) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    auto delay = kBackoffMin;
+    auto polls = 0;
+    while (!SDK::UEngine::GetEngine() || !SDK::UWorld::GetWorld()) {
+        Backoff(delay);
+        ++polls;
     }
-    while (!SDK::UWorld::GetWorld()) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    GTimeToReady.store(MicrosecondsSinceInstall(), std::memory_order_relaxed);
+    LOG(INFO) << "Engine ready after " << GTimeToReady.load(std::memory_order_relaxed) / 1000.0 << " ms (" << polls
+              << " polls)";
+}
+
+// all calls into the original go through here so the profiler sees them
+void CallProcessEvent(SDK::UObject *object, SDK::UFunction *function, void *params) {
+    if (!GProfilerEnabled.load(std::memory_order_relaxed) || !ProfilerShouldSample()) [[likely]]
+        return GProcessEvent(object, function, params);
+    const auto weight = ProfilerArm();
+    const auto start = ProfilerNow();
+    GProcessEvent(object, function, params);
+    ProfilerRecord(function, ProfilerNow() - start, weight);
+}
+
+// the overridden items of each Gbx block, re-read from the snapshot only when the block's serial moves (game thread)
+struct GbxBlockItems {
+    uint64_t Serial = ~0ull;
+    std::vector<std::pair<uint16_t, float>> Items;
+};
+std::array<GbxBlockItems, kGbxBlocks> GGbxBlocks;
+
+// blocks without an overridden item are skipped whole, so the ~80 Gbx fields cost nothing until one is used
+void MergeGbxBlocks(SDK::FPostProcessSettings &settings, const override_snapshot &snapshot) {
+    for (uint32_t active = snapshot.gbx_active; active; active &= active - 1) {
+        const auto block = std::countr_zero(active);
+        auto &cached = GGbxBlocks[block];
+        if (cached.Serial != snapshot.gbx_serials[block]) {
+            cached.Serial = snapshot.gbx_serials[block];
+            cached.Items.clear();
+            for (std::size_t i = 0; i < kItemCount; ++i)
+                if (float value = 0.f; gItemBlocks[i] == block && get_own_item(snapshot.settings, i, value))
+                    cached.Items.emplace_back(static_cast<uint16_t>(i), value);
+        }
+        for (const auto &[item, value] : cached.Items)
+            set_item(settings, item, true, value);
     }
 }
 
-void MyBlueprintModifyPostProcess(SDK::Params::CameraModifier_BlueprintModifyPostProcess *params) {
-    auto weight = myPostProcessBlendWeight.load(std::memory_order_acquire);
-    if (weight > 0.f) {
-        params->PostProcessBlendWeight = weight;
-        params->PostProcessSettings |= myPostProcessSettings;
+void MyBlueprintModifyCamera(SDK::Params::CameraModifier_BlueprintModifyCamera *params) {
+    const auto &snapshot = read_overrides();
+    GSnapshotPinned = true;
+    if (snapshot.view.enabled && snapshot.weight > 0.f)
+        apply_view(snapshot.view, *params);
+}
+
+void MyBlueprintModifyPostProcess(SDK::UCameraModifier *modifier,
+                                  SDK::Params::CameraModifier_BlueprintModifyPostProcess *params) {
+    const auto &snapshot = GSnapshotPinned ? current_overrides() : read_overrides();
+    GSnapshotPinned = false;
+    const auto layout = GLayoutMode.load(std::memory_order_relaxed);
+    if (snapshot.weight > 0.f && layout != LayoutMode::Off) {
+        params->PostProcessBlendWeight = snapshot.weight;
+        if (layout == LayoutMode::Compiled) [[likely]]
+            params->PostProcessSettings |= snapshot.settings;
+        else
+            MergeLive(params->PostProcessSettings, snapshot.settings);
+        MergeGbxBlocks(params->PostProcessSettings, snapshot);
+        evaluate_curves(snapshot, params->PostProcessSettings);
+        if (auto camera = modifier->CameraOwner)
+            evaluate_zones(snapshot, camera->CameraCachePrivate.POV.Location, params->PostProcessSettings);
     }
 }
 
+// APlayerCameraManager::PostProcessBlendCacheWeights and PostProcessBlendCacheOrders, right after the cache itself
+// (Pad_2DE8 in the SDK). Orders are EViewTargetBlendOrder, an int-sized native enum.
+struct BlendCacheTail {
+    SDK::TArray<float> Weights;
+    SDK::TArray<int32_t> Orders;
+};
+static_assert(sizeof(BlendCacheTail) == sizeof(SDK::APlayerCameraManager::Pad_2DE8));
+
+// BlendCache delivery: one copy of the snapshot into a new cache entry, evaluated in place. The entry is appended
+// only into spare capacity, since growing an engine TArray needs the engine's allocator; the cache is Reset() at
+// the start of every camera update, so after one Modifier-mode update has grown it there is room from then on.
+bool InjectBlendCache(SDK::UCameraModifier *modifier) {
+    // pin so a fallback to MyBlueprintModifyPostProcess delivers the same snapshot
+    const auto &snapshot = GSnapshotPinned ? current_overrides() : read_overrides();
+    GSnapshotPinned = true;
+    auto camera = modifier->CameraOwner;
+    if (!camera || snapshot.weight <= 0.f) {
+        GSnapshotPinned = false;
+        return true; // nothing to deliver; the skipped dispatch leaves the weight at 0, so the engine adds nothing
+    }
+    if (GLayoutMode.load(std::memory_order_relaxed) != LayoutMode::Compiled) {
+        // the cache entry is a whole FPostProcessSettings, which only the SDK layout can fill
+        LOG_N_TIMES(1, WARNING) << "FPostProcessSettings layout differs from the SDK, staying on the camera modifier";
+        GBlendCacheFallbacks.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    auto &cache = camera->PostProcessBlendCache;
+    auto &tail = *reinterpret_cast<BlendCacheTail *>(camera->Pad_2DE8);
+    if (tail.Weights.Num() != cache.Num() || tail.Orders.Num() != cache.Num()) {
+        LOG_N_TIMES(1, ERROR) << "PostProcessBlendCache layout mismatch, staying on the camera modifier";
+        GBlendCacheFallbacks.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    if (cache.Num() >= cache.Max() || tail.Weights.Num() >= tail.Weights.Max() ||
+        tail.Orders.Num() >= tail.Orders.Max()) {
+        GBlendCacheFallbacks.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    GSnapshotPinned = false;
+    // our settings never own engine memory (no blendables, no arrays), so a plain copy is safe to hand over
+    cache.Add(snapshot.settings);
+    auto &settings = const_cast<SDK::FPostProcessSettings *>(cache.GetDataPtr())[cache.Num() - 1];
+    evaluate_curves(snapshot, settings);
+    evaluate_zones(snapshot, camera->CameraCachePrivate.POV.Location, settings);
+    tail.Weights.Add(snapshot.weight);
+    tail.Orders.Add(0); // VTBlendOrder_Base, what AddCachedPPBlend defaults to
+    return true;
+}
+
+// game thread, from the discovery path
+void InstallCameraModifier(SDK::AOakPlayerCameraManager *camera) {
+    LOG(WARNING) << "Installing CameraModifier";
+    auto modifier = camera->AddNewCameraModifier(SDK::UCameraModifier::StaticClass());
+    if (!modifier) {
+        LOG(ERROR) << "AddNewCameraModifier failed";
+        return;
+    }
+    modifier->priority = 0;
+    modifier->ALPHA = 1.0f;
+    auto &slot = GModifierSlots[GModifierSlot ^= 1];
+    slot.Modifier = modifier;
+    slot.ModifyPostProcess = modifier->Class->GetFunction("CameraModifier", "BlueprintModifyPostProcess");
+    slot.ModifyCamera = modifier->Class->GetFunction("CameraModifier", "BlueprintModifyCamera");
+    slot.ModifierHandle = ObjectHandle::Of(modifier);
+    slot.CameraHandle = ObjectHandle::Of(camera);
+    MyCameraModifier.store(&slot, std::memory_order_release);
+    GModifierInstalls.fetch_add(1, std::memory_order_relaxed);
+    LOG(WARNING) << "Installed CameraModifier on " << camera->GetName();
+}
+
+// game thread; a camera that only paused (menus, loading screens) keeps both handles and keeps our modifier
+void CheckCameraModifier() {
+    GModifierSuspect.store(false, std::memory_order_relaxed);
+    const auto my = MyCameraModifier.load(std::memory_order_acquire);
+    if (!my || (my->ModifierHandle.Get() && my->CameraHandle.Get()))
+        return;
+    GModifierRearms.fetch_add(1, std::memory_order_relaxed);
+    MyCameraModifier.store(nullptr, std::memory_order_release);
+    LOG(WARNING) << "CameraModifier or its camera manager was destroyed, re-arming discovery";
+}
+
 void MyProcessEvent(SDK::UObject *object, SDK::UFunction *function, void *params) {
-    if (auto pair = MyCameraModifier.load(std::memory_order_acquire)) {
-        auto modifier = pair->first;
-        auto modify = pair->second;
-        if (object == modifier && function == modify) {
-            GProcessEvent(object, function, params);
-            MyBlueprintModifyPostProcess(static_cast<SDK::Params::CameraModifier_BlueprintModifyPostProcess *>(params));
-            LOG_N_TIMES(1, WARNING) << "Called MyBlueprintModifyPostProcess";
-            return;
+    if (GModifierSuspect.load(std::memory_order_relaxed))
+        CheckCameraModifier();
+    if (auto my = MyCameraModifier.load(std::memory_order_acquire)) {
+        if (object == my->Modifier) {
+            if (function == my->ModifyPostProcess) {
+                GModifierCalls.store(GModifierCalls.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                DrainGameTasks();
+                TickReflection();
+                TickCensus();
+                SampleStreaming();
+                StepTickInventory();
+                const auto start = std::chrono::steady_clock::now();
+                if (DeliveryModeForUpdate() == DeliveryMode::BlendCache && InjectBlendCache(my->Modifier)) {
+                    DeliveryRecord(DeliveryMode::BlendCache, start);
+                    LOG_N_TIMES(1, WARNING) << "Injected into PostProcessBlendCache";
+                    return;
+                }
+                CallProcessEvent(object, function, params);
+                MyBlueprintModifyPostProcess(
+                    my->Modifier, static_cast<SDK::Params::CameraModifier_BlueprintModifyPostProcess *>(params));
+                DeliveryRecord(DeliveryMode::Modifier, start);
+                LOG_N_TIMES(1, WARNING) << "Called MyBlueprintModifyPostProcess";
+                return;
+            }
+            if (function == my->ModifyCamera) {
+                CallProcessEvent(object, function, params);
+                MyBlueprintModifyCamera(static_cast<SDK::Params::CameraModifier_BlueprintModifyCamera *>(params));
+                return;
+            }
         }
     } else if (object && function) {
         auto name = function->GetName();
@@ -109,20 +326,12 @@ void MyProcessEvent(SDK::UObject *object, SDK::UFunction *function, void *params
         if (object->Outer && object->Outer->IsA(SDK::AOakPlayerCameraManager::StaticClass()) &&
             name == "BlueprintModifyPostProcess") {
             LOG(INFO) << "Found " << object->GetName() << " | " << name;
-            static std::once_flag flag;
-            std::call_once(flag, [&] {
-                LOG(WARNING) << "Installing CameraModifier";
-                auto outer = reinterpret_cast<SDK::AOakPlayerCameraManager *>(object->Outer);
-                auto modifier = outer->AddNewCameraModifier(SDK::UCameraModifier::StaticClass());
-                modifier->priority = 0;
-                modifier->ALPHA = 1.0f;
-                auto modify = modifier->Class->GetFunction("CameraModifier", "BlueprintModifyPostProcess");
-                MyCameraModifier.store(new std::pair{modifier, modify}, std::memory_order_release);
-                LOG(WARNING) << "Installed CameraModifier";
-            });
+            DrainGameTasks(); // game thread; keeps the queue moving until our own modifier takes over
+            if (!MyCameraModifier.load(std::memory_order_acquire))
+                InstallCameraModifier(reinterpret_cast<SDK::AOakPlayerCameraManager *>(object->Outer));
         }
     }
-    return GProcessEvent(object, function, params);
+    return CallProcessEvent(object, function, params);
 }
 
 void InstallMyProcessEvent() {
@@ -144,6 +353,7 @@ void InstallMyProcessEvent() {
     auto pDetour = &MyProcessEvent;
     auto ppOriginal = reinterpret_cast<void **>(&GProcessEvent);
     auto retry = 0;
+    auto delay = kBackoffMin;
     while (true) {
         status = MH_CreateHook(pTarget, pDetour, ppOriginal);
         if (status == MH_OK)
@@ -155,7 +365,7 @@ void InstallMyProcessEvent() {
             MH_Uninitialize();
             return;
         }
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        Backoff(delay);
     }
     status = MH_EnableHook(pTarget);
     if (status != MH_OK) {
@@ -164,11 +374,48 @@ void InstallMyProcessEvent() {
         MH_Uninitialize();
         return;
     }
-    LOG(WARNING) << "Installed ProcessEvent hook";
+    GTimeToHook.store(MicrosecondsSinceInstall(), std::memory_order_relaxed);
+    LOG(WARNING) << "Installed ProcessEvent hook " << GTimeToHook.load(std::memory_order_relaxed) / 1000.0
+                 << " ms after load (" << retry << " retries)";
 }
 
 } // namespace
 
+std::atomic<int64_t> GTimeToReady = -1;
+std::atomic<int64_t> GTimeToHook = -1;
+std::atomic<uint32_t> GModifierInstalls = 0;
+std::atomic<uint32_t> GModifierRearms = 0;
+
+void WatchCameraModifier() {
+    static uint64_t seen = 0;
+    static int idle = 0;
+    if (!MyCameraModifier.load(std::memory_order_relaxed)) {
+        idle = 0;
+        return;
+    }
+    if (const auto calls = GModifierCalls.load(std::memory_order_relaxed); calls != seen) {
+        seen = calls;
+        idle = 0;
+        return;
+    }
+    if (++idle < kStalePresents)
+        return;
+    // the camera manager we hang off may be gone (map change, respawn) or only paused; the handles can only be
+    // checked safely on the game thread, so the next ProcessEvent does it and re-arms discovery if either is dead
+    idle = 0;
+    GModifierSuspect.store(true, std::memory_order_relaxed);
+}
+
+void NotifyEngineMaybeReady() {
+    if (GTimeToHook.load(std::memory_order_relaxed) >= 0)
+        return;
+    {
+        std::lock_guard lock(GReadyMutex);
+        GReadyPoked = true;
+    }
+    GReadyCondition.notify_one();
+}
+
 void UninstallHook() {
     GUninstalling.store(true, std::memory_order_release);
     std::lock_guard guard(GMutex);
@@ -204,13 +451,20 @@ void UninstallHook() {
 }
 
 void InstallHook() {
+    GInstallStart = std::chrono::steady_clock::now();
+    GTimeToReady.store(-1, std::memory_order_relaxed);
+    GTimeToHook.store(-1, std::memory_order_relaxed);
     std::thread([] {
         WaitForReady();
         InstallMyProcessEvent();
-        auto engine = SDK::UEngine::GetEngine();
-        SDK::UInputSettings::GetDefaultObj()->ConsoleKeys[0].KeyName =
-            SDK::UKismetStringLibrary::Conv_StringToName(L"F2");
-        auto console = SDK::UGameplayStatics::SpawnObject(engine->ConsoleClass, engine->GameViewport);
-        engine->GameViewport->ViewportConsole = reinterpret_cast<SDK::UConsole *>(console);
+        EnqueueGameTask(BuildPostProcessLayout);
+        EnqueueGameTask([] {
+            auto engine = SDK::UEngine::GetEngine();
+            SDK::UInputSettings::GetDefaultObj()->ConsoleKeys[0].KeyName =
+                SDK::UKismetStringLibrary::Conv_StringToName(L"F2");
+            auto console = SDK::UGameplayStatics::SpawnObject(engine->ConsoleClass, engine->GameViewport);
+            engine->GameViewport->ViewportConsole = reinterpret_cast<SDK::UConsole *>(console);
+            LOG(INFO) << "Console bound to F2";
+        });
     }).detach();
 }
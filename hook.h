@@ -1,4 +1,20 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+
 extern void InstallHook();
-extern void UninstallHook();
\ No newline at end of file
+extern void UninstallHook();
+
+// wakes the install thread for an early readiness check; cheap once the hook is in
+extern void NotifyEngineMaybeReady();
+
+// startup metrics in microseconds since InstallHook(), -1 until reached
+extern std::atomic<int64_t> GTimeToReady;
+extern std::atomic<int64_t> GTimeToHook;
+
+// once our modifier stops seeing camera updates, has the game thread re-arm discovery if it or its camera manager was
+// destroyed; called from reshade_present
+extern void WatchCameraModifier();
+extern std::atomic<uint32_t> GModifierInstalls;
+extern std::atomic<uint32_t> GModifierRearms;
@@ -0,0 +1,269 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <imgui.h>
+#include <reshade.hpp>
+
+#include <easylogging++.h>
+
+#include "abtest.h"
+#include "addon.h"
+#include "cvars.h"
+#include "governor.h"
+#include "journal.h"
+#include "mixer.h"
+#include "sweep.h"
+
+// =========================
+// Versions: a gate flag and one pointer per chunk of kChunkItems schema items; unchanged chunks are shared
+// =========================
+static constexpr std::size_t kChunkItems = 16;
+static constexpr std::size_t kChunks = (kItemCount + kChunkItems - 1) / kChunkItems;
+static constexpr std::size_t kMaxVersions = 4096;
+
+static std::size_t gLiveChunks = 0; // chunks referenced by any version, for the memory readout
+
+struct chunk {
+    std::array<bool, kChunkItems> enables{};
+    std::array<Value, kChunkItems> values{};
+
+    chunk() { ++gLiveChunks; }
+    chunk(const chunk &other) : enables(other.enables), values(other.values) { ++gLiveChunks; }
+    chunk &operator=(const chunk &) = delete;
+    ~chunk() { --gLiveChunks; }
+};
+
+using chunk_ptr = std::shared_ptr<const chunk>;
+
+struct version {
+    bool enabled = false;
+    std::array<chunk_ptr, kChunks> chunks{};
+    std::string label;
+    std::chrono::steady_clock::time_point time;
+};
+
+static constexpr std::size_t chunk_end(std::size_t c) { return std::min((c + 1) * kChunkItems, kItemCount); }
+
+static bool same_item(const chunk &c, std::size_t idx) {
+    const auto slot = idx % kChunkItems;
+    return c.enables[slot] == gEnables[idx] && std::memcmp(&c.values[slot], &gValues[idx], sizeof(Value)) == 0;
+}
+
+static bool same_chunk(const chunk &c, std::size_t first) {
+    for (std::size_t i = first; i < chunk_end(first / kChunkItems); ++i)
+        if (!same_item(c, i))
+            return false;
+    return true;
+}
+
+static chunk_ptr capture_chunk(std::size_t c) {
+    auto fresh = std::make_shared<chunk>();
+    for (std::size_t i = c * kChunkItems; i < chunk_end(c); ++i) {
+        fresh->enables[i % kChunkItems] = gEnables[i];
+        fresh->values[i % kChunkItems] = gValues[i];
+    }
+    return fresh;
+}
+
+// =========================
+// Ring: versions [0, gCount) from oldest to newest, gCursor the one the override state shows
+// =========================
+static std::vector<version> gRing;
+static std::size_t gFirst = 0;
+static std::size_t gCount = 0;
+static std::size_t gCursor = 0;
+
+static version &at(std::size_t i) { return gRing[(gFirst + i) % kMaxVersions]; }
+
+// a new version after an undo drops the ones that could have been redone
+static void push(version &&next) {
+    for (std::size_t i = gCursor + 1; i < gCount; ++i)
+        at(i) = {};
+    gCount = gCount == 0 ? 0 : gCursor + 1;
+    if (gCount == kMaxVersions) {
+        at(0) = {};
+        gFirst = (gFirst + 1) % kMaxVersions;
+        --gCount;
+    }
+    at(gCount) = std::move(next);
+    gCursor = gCount++;
+}
+
+// the A/B test, sweep and mixer write the override arrays themselves and put them back when they stop
+static bool state_owned() { return ab_test_running() || sweep_running() || mixer_running(); }
+
+// =========================
+// Recording
+// =========================
+void reset_journal() {
+    gRing.clear();
+    gRing.resize(kMaxVersions);
+    gFirst = gCount = gCursor = 0;
+    version base{gEnabled, {}, "Loaded from preset", std::chrono::steady_clock::now()};
+    for (std::size_t c = 0; c < kChunks; ++c)
+        base.chunks[c] = capture_chunk(c);
+    push(std::move(base));
+}
+
+// copies only the edited item into the chunk: others in it may be held by the governor for the moment
+void journal_item(std::size_t idx) {
+    if (gCount == 0 || state_owned())
+        return;
+    const auto &head = at(gCursor);
+    const auto c = idx / kChunkItems;
+    if (same_item(*head.chunks[c], idx))
+        return;
+    auto edited = std::make_shared<chunk>(*head.chunks[c]);
+    edited->enables[idx % kChunkItems] = gEnables[idx];
+    edited->values[idx % kChunkItems] = gValues[idx];
+    version next{head.enabled, head.chunks, kItems[idx].key, std::chrono::steady_clock::now()};
+    next.chunks[c] = std::move(edited);
+    push(std::move(next));
+}
+
+void journal_gate() {
+    if (gCount == 0 || state_owned() || at(gCursor).enabled == gEnabled)
+        return;
+    version next{gEnabled, at(gCursor).chunks, gEnabled ? "Gate on" : "Gate off", std::chrono::steady_clock::now()};
+    push(std::move(next));
+}
+
+void journal_state(std::string_view label) {
+    if (gCount == 0 || state_owned())
+        return;
+    const auto &head = at(gCursor);
+    version next{gEnabled, head.chunks, std::string(label), std::chrono::steady_clock::now()};
+    bool changed = head.enabled != gEnabled;
+    for (std::size_t c = 0; c < kChunks; ++c) {
+        if (same_chunk(*head.chunks[c], c * kChunkItems))
+            continue;
+        next.chunks[c] = capture_chunk(c);
+        changed = true;
+    }
+    if (changed)
+        push(std::move(next));
+}
+
+// =========================
+// Restoring
+// =========================
+// The whole version goes into the override arrays, so whatever the governor was holding is replaced too; only the
+// items that differ from the version being left, found through the chunks that differ, are written back to the preset.
+static void restore(reshade::api::effect_runtime *runtime, std::size_t target) {
+    const auto &from = at(gCursor);
+    const auto &to = at(target);
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t c = 0; c < kChunks; ++c) {
+        const auto &src = *to.chunks[c];
+        for (std::size_t i = c * kChunkItems; i < chunk_end(c); ++i) {
+            gEnables[i] = src.enables[i % kChunkItems];
+            gValues[i] = src.values[i % kChunkItems];
+        }
+    }
+    const bool gate_changed = gEnabled != to.enabled;
+    gEnabled = to.enabled;
+    reset_governor();
+    apply_overrides();
+    const auto us = std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+    std::size_t saved = 0;
+    for (std::size_t c = 0; c < kChunks; ++c) {
+        if (from.chunks[c] == to.chunks[c])
+            continue;
+        for (std::size_t i = c * kChunkItems; i < chunk_end(c); ++i) {
+            if (same_item(*from.chunks[c], i))
+                continue;
+            save_item(runtime, i);
+            ++saved;
+        }
+    }
+    if (gate_changed) {
+        save_gate(runtime);
+        if (gEnabled)
+            apply_cvars();
+        else
+            revert_cvars();
+    }
+    LOG(INFO) << (target < gCursor ? "Undo to " : "Redo to ") << to.label << " in " << us << " us, " << saved
+              << " items saved";
+    gCursor = target;
+}
+
+static bool can_undo() { return gCount != 0 && gCursor > 0 && !state_owned(); }
+static bool can_redo() { return gCursor + 1 < gCount && !state_owned(); }
+
+void journal_shortcuts(reshade::api::effect_runtime *runtime) {
+    const auto &io = ImGui::GetIO();
+    if (!io.KeyCtrl || io.WantTextInput)
+        return;
+    if (ImGui::IsKeyPressed(ImGuiKey_Z, false) && !io.KeyShift && can_undo())
+        restore(runtime, gCursor - 1);
+    else if ((ImGui::IsKeyPressed(ImGuiKey_Y, false) || (io.KeyShift && ImGui::IsKeyPressed(ImGuiKey_Z, false))) &&
+             can_redo())
+        restore(runtime, gCursor + 1);
+}
+
+// =========================
+// Overlay
+// =========================
+void draw_journal(reshade::api::effect_runtime *runtime) {
+    const auto chunk_kb = static_cast<float>(gLiveChunks * sizeof(chunk)) / 1024.f;
+    const auto root_kb = static_cast<float>(gCount * sizeof(version)) / 1024.f;
+    const auto full_kb = static_cast<float>(gCount * kItemCount * (sizeof(bool) + sizeof(Value))) / 1024.f;
+    ImGui::TextDisabled("%zu of %zu versions, %zu chunks: %.0f KB (%.0f KB as full copies)", gCount, kMaxVersions,
+                        gLiveChunks, chunk_kb + root_kb, full_kb);
+
+    ImGui::BeginDisabled(!can_undo());
+    if (ImGui::Button("Undo"))
+        restore(runtime, gCursor - 1);
+    ImGui::EndDisabled();
+    ImGui::SameLine();
+    ImGui::BeginDisabled(!can_redo());
+    if (ImGui::Button("Redo"))
+        restore(runtime, gCursor + 1);
+    ImGui::EndDisabled();
+    ImGui::SameLine();
+    ImGui::TextDisabled("Ctrl+Z / Ctrl+Y");
+
+    // newest first; versions past the cursor are the ones a new edit would drop
+    ImGui::BeginDisabled(state_owned());
+    constexpr auto flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY;
+    if (gCount != 0 && ImGui::BeginTable("##journal", 2, flags, ImVec2(0, 200))) {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("Change");
+        ImGui::TableSetupColumn("Age", ImGuiTableColumnFlags_WidthFixed);
+        ImGui::TableHeadersRow();
+        const auto now = std::chrono::steady_clock::now();
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(gCount));
+        while (clipper.Step()) {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+                const auto i = gCount - 1 - static_cast<std::size_t>(row);
+                const auto &v = at(i);
+                ImGui::PushID(row);
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                if (i > gCursor)
+                    ImGui::PushStyleColor(ImGuiCol_Text, ImGui::GetStyleColorVec4(ImGuiCol_TextDisabled));
+                if (ImGui::Selectable(v.label.c_str(), i == gCursor, ImGuiSelectableFlags_SpanAllColumns) &&
+                    i != gCursor)
+                    restore(runtime, i);
+                if (i > gCursor)
+                    ImGui::PopStyleColor();
+                ImGui::TableNextColumn();
+                ImGui::Text("%.0f s", std::chrono::duration<float>(now - v.time).count());
+                ImGui::PopID();
+            }
+        }
+        ImGui::EndTable();
+    }
+    ImGui::EndDisabled();
+}
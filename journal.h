@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+namespace reshade::api {
+struct effect_runtime;
+}
+
+// Undo/redo for the override state: every edit becomes an immutable version in a bounded ring. Versions share the
+// schema's items in chunks of 16, so an edit copies only the chunk it touched and the small root pointing at the rest,
+// and thousands of versions cost little more than the chunks that actually differ. Undo, redo and jumping restore a
+// version into the override arrays and publish it as one snapshot, then write the items whose chunks differ back to
+// the ReShade preset. Nothing is recorded or restored while an A/B test, sweep or mix owns the override state.
+
+// drops the history and starts over from the current state, e.g. after a preset load (render thread)
+void reset_journal();
+// records the current state after one item, the gate, or everything (a library switch) changed (render thread)
+void journal_item(std::size_t idx);
+void journal_gate();
+void journal_state(std::string_view label);
+
+// Ctrl+Z / Ctrl+Y (Ctrl+Shift+Z) while the overlay is open and no text field has focus
+void journal_shortcuts(reshade::api::effect_runtime *runtime);
+void draw_journal(reshade::api::effect_runtime *runtime);
@@ -0,0 +1,319 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <imgui.h>
+
+#include <easylogging++.h>
+
+#include <SDK/Engine_classes.hpp>
+#include <SDK/Engine_parameters.hpp>
+
+#include "addon.h"
+#include "layout.h"
+#include "reflect.h"
+
+std::atomic<LayoutMode> GLayoutMode = LayoutMode::Compiled;
+
+namespace {
+
+constexpr int16_t kNoShow = -1;
+
+struct LiveItem {
+    FieldStatus Status = FieldStatus::Missing;
+    const PropertyDesc *Value = nullptr;
+    const PropertyDesc *Override = nullptr;
+    int16_t Show = kNoShow;       // index into PostProcessLayout::Shows, for items in a Gbx sub-struct
+    uint32_t CompiledOffset = 0;  // first byte the compiled setter writes for the value
+};
+
+struct PostProcessLayout {
+    int32_t Size = 0; // UStruct::Size of the live struct
+    std::size_t Pairs = 0;
+    std::array<LiveItem, kItemCount> Items{};
+    std::vector<const PropertyDesc *> Shows; // bShow<SubStruct> gates, one per Gbx sub-struct with a schema item
+    std::vector<OverridePair> Unlisted;      // paired properties the schema doesn't have
+    std::array<uint32_t, 4> Counts{};        // per FieldStatus
+    bool ParamsMatch = true;
+    float BuildMs = 0.f;
+};
+
+// built once on the game thread and never changed again, so readers only need the acquire on the pointer
+PostProcessLayout GBuilt;
+std::atomic<const PostProcessLayout *> GLayout = nullptr;
+
+bool Compatible(PropertyKind kind, bool is_int) {
+    const bool real = kind == PropertyKind::Float || kind == PropertyKind::Double;
+    return real != is_int;
+}
+
+// offset of a property of the BlueprintModifyPostProcess parameter block, -1 if it has none by that name
+int32_t ParamOffset(SDK::UStruct *function, const char *name) {
+    for (auto field = function->ChildProperties; field; field = field->Next)
+        if (field->Name.ToString() == name)
+            return static_cast<SDK::FProperty *>(field)->Offset;
+    return -1;
+}
+
+bool CheckParams() {
+    using Params = SDK::Params::CameraModifier_BlueprintModifyPostProcess;
+    auto function = SDK::UCameraModifier::StaticClass()->GetFunction("CameraModifier", "BlueprintModifyPostProcess");
+    if (!function) {
+        LOG(ERROR) << "CameraModifier.BlueprintModifyPostProcess not found";
+        return false;
+    }
+    return ParamOffset(function, "PostProcessBlendWeight") == offsetof(Params, PostProcessBlendWeight) &&
+           ParamOffset(function, "PostProcessSettings") == offsetof(Params, PostProcessSettings);
+}
+
+// what the compiled setter writes into a zeroed struct, against what the live layout says it should write
+bool ProbeMatches(std::size_t idx, const LiveItem &item, const std::vector<const PropertyDesc *> &shows, bool enabled,
+                  float value, std::vector<uint8_t> &compiled, std::vector<uint8_t> &live) {
+    static SDK::FPostProcessSettings probe;
+    probe = {};
+    set_own_item(probe, idx, enabled, value);
+    std::ranges::fill(compiled, 0);
+    std::memcpy(compiled.data(), &probe, sizeof(probe));
+
+    std::ranges::fill(live, 0);
+    PropertyOverride writes[3] = {EncodeOverride(*item.Override, enabled ? 1.0 : 0.0),
+                                  EncodeOverride(*item.Value, value)};
+    std::size_t count = 2;
+    if (item.Show != kNoShow)
+        writes[count++] = EncodeOverride(*shows[item.Show], enabled ? 1.0 : 0.0);
+    for (std::size_t i = 0; i < count; ++i)
+        if (writes[i].Offset + writes[i].Size > live.size())
+            return false;
+    ApplyOverrides(live.data(), std::span(writes, count));
+    return compiled == live;
+}
+
+uint32_t FirstWritten(std::size_t idx) {
+    static SDK::FPostProcessSettings probe;
+    probe = {};
+    set_own_item(probe, idx, false, 1.f);
+    const auto bytes = reinterpret_cast<const uint8_t *>(&probe);
+    const auto it = std::find_if(bytes, bytes + sizeof(probe), [](uint8_t b) { return b != 0; });
+    return static_cast<uint32_t>(it - bytes);
+}
+
+void Build(SDK::UStruct *type, PostProcessLayout &layout) {
+    const auto &desc = DescribeStruct(type);
+    layout.Size = type->Size;
+
+    // schema keys are leaf names; Gbx items live one struct down, behind a bShow<SubStruct> gate
+    const auto pairs = PairOverrides(desc);
+    layout.Pairs = pairs.size();
+    std::unordered_map<std::string, std::size_t> by_leaf;
+    for (std::size_t p = 0; p < pairs.size(); ++p) {
+        const auto &name = pairs[p].Value->Name;
+        const auto dot = name.rfind('.');
+        by_leaf.emplace(dot == std::string::npos ? name : name.substr(dot + 1), p);
+    }
+    std::vector<bool> listed(pairs.size());
+    for (std::size_t i = 0; i < kItemCount; ++i) {
+        auto &item = layout.Items[i];
+        auto it = by_leaf.find(kItems[i].key);
+        if (it == by_leaf.end())
+            continue;
+        listed[it->second] = true;
+        item.Value = pairs[it->second].Value;
+        item.Override = pairs[it->second].Override;
+        if (const auto dot = item.Value->Name.find('.'); dot != std::string::npos) {
+            if (auto show = desc.Find("bShow" + item.Value->Name.substr(0, dot))) {
+                auto found = std::ranges::find(layout.Shows, show);
+                item.Show = static_cast<int16_t>(found - layout.Shows.begin());
+                if (found == layout.Shows.end())
+                    layout.Shows.push_back(show);
+            }
+        }
+    }
+    for (std::size_t p = 0; p < pairs.size(); ++p)
+        if (!listed[p])
+            layout.Unlisted.push_back(pairs[p]);
+
+    const auto size = std::max<std::size_t>(sizeof(SDK::FPostProcessSettings), std::max(layout.Size, 0));
+    std::vector<uint8_t> compiled(size), live(size);
+    for (std::size_t i = 0; i < kItemCount; ++i) {
+        auto &item = layout.Items[i];
+        item.CompiledOffset = FirstWritten(i);
+        if (item.Value) {
+            if (ProbeMatches(i, item, layout.Shows, true, 0.f, compiled, live) &&
+                ProbeMatches(i, item, layout.Shows, false, 1.f, compiled, live))
+                item.Status = FieldStatus::Ok;
+            else if (Compatible(item.Value->Kind, kItems[i].is_int))
+                item.Status = FieldStatus::Moved;
+            else
+                item.Status = FieldStatus::Retyped;
+        }
+        ++layout.Counts[static_cast<std::size_t>(item.Status)];
+        if (item.Status != FieldStatus::Ok)
+            LOG(WARNING) << "FPostProcessSettings." << kItems[i].key << ": " << FieldStatusName(item.Status);
+    }
+    layout.ParamsMatch = CheckParams();
+}
+
+void Write(SDK::FPostProcessSettings &settings, const PostProcessLayout &layout, const LiveItem &item, bool enabled,
+           float value) {
+    PropertyOverride writes[3] = {EncodeOverride(*item.Override, enabled ? 1.0 : 0.0),
+                                  EncodeOverride(*item.Value, value)};
+    std::size_t count = 2;
+    if (item.Show != kNoShow && enabled)
+        writes[count++] = EncodeOverride(*layout.Shows[item.Show], 1.0);
+    ApplyOverrides(&settings, std::span(writes, count));
+}
+
+} // namespace
+
+void BuildPostProcessLayout() {
+    if (GLayout.load(std::memory_order_acquire))
+        return;
+    const auto start = std::chrono::steady_clock::now();
+    auto type = SDK::UObject::FindObject<SDK::UScriptStruct>("ScriptStruct Engine.PostProcessSettings",
+                                                             SDK::EClassCastFlags::ScriptStruct);
+    if (!type) {
+        LOG(ERROR) << "ScriptStruct Engine.PostProcessSettings not found, keeping the SDK layout";
+        return;
+    }
+    Build(type, GBuilt);
+    GBuilt.BuildMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    auto mode = LayoutMode::Compiled;
+    if (!GBuilt.ParamsMatch)
+        mode = LayoutMode::Off;
+    else if (GBuilt.Counts[static_cast<std::size_t>(FieldStatus::Ok)] != kItemCount ||
+             GBuilt.Size != static_cast<int32_t>(sizeof(SDK::FPostProcessSettings)))
+        mode = LayoutMode::Live;
+    GLayout.store(&GBuilt, std::memory_order_release);
+    GLayoutMode.store(mode, std::memory_order_release);
+
+    LOG(INFO) << "FPostProcessSettings: " << GBuilt.Size << " bytes live, " << sizeof(SDK::FPostProcessSettings)
+              << " in the SDK, " << GBuilt.Pairs << " overridable properties, "
+              << GBuilt.Counts[static_cast<std::size_t>(FieldStatus::Ok)] << " of " << kItemCount
+              << " schema items match, " << GBuilt.Unlisted.size() << " not in the schema (" << GBuilt.BuildMs
+              << " ms)";
+    if (mode == LayoutMode::Live)
+        LOG(WARNING) << "FPostProcessSettings layout differs from the SDK, delivering through live offsets";
+    else if (mode == LayoutMode::Off)
+        LOG(ERROR) << "BlueprintModifyPostProcess parameters differ from the SDK, overrides are not delivered";
+}
+
+FieldStatus PostProcessFieldStatus(std::size_t idx) {
+    auto layout = GLayout.load(std::memory_order_acquire);
+    return layout ? layout->Items[idx].Status : FieldStatus::Ok;
+}
+
+const char *FieldStatusName(FieldStatus status) {
+    switch (status) {
+    case FieldStatus::Ok:
+        return "ok";
+    case FieldStatus::Moved:
+        return "moved";
+    case FieldStatus::Retyped:
+        return "retyped";
+    case FieldStatus::Missing:
+        return "missing";
+    }
+    return "?";
+}
+
+void WriteLiveItem(SDK::FPostProcessSettings &settings, std::size_t idx, bool enabled, float value) {
+    const auto &layout = *GLayout.load(std::memory_order_acquire);
+    if (const auto &item = layout.Items[idx]; item.Status != FieldStatus::Missing)
+        Write(settings, layout, item, enabled, value);
+}
+
+bool ReadLiveItem(const SDK::FPostProcessSettings &settings, std::size_t idx, float &value) {
+    const auto &item = GLayout.load(std::memory_order_acquire)->Items[idx];
+    if (item.Status == FieldStatus::Missing) {
+        value = 0.f;
+        return false;
+    }
+    value = static_cast<float>(ReadProperty(&settings, *item.Value));
+    return ReadProperty(&settings, *item.Override) != 0.0;
+}
+
+void MergeLive(SDK::FPostProcessSettings &settings, const SDK::FPostProcessSettings &own) {
+    const auto &layout = *GLayout.load(std::memory_order_acquire);
+    for (std::size_t i = 0; i < kItemCount; ++i) {
+        const auto &item = layout.Items[i];
+        if (item.Status == FieldStatus::Missing || gItemBlocks[i] != kGbxBlocks)
+            continue;
+        float value = 0.f;
+        const bool enabled = get_own_item(own, i, value);
+        Write(settings, layout, item, enabled, value);
+    }
+}
+
+void DrawLayout() {
+    auto layout = GLayout.load(std::memory_order_acquire);
+    if (!layout) {
+        ImGui::TextDisabled("Not built yet, waiting for the engine");
+        return;
+    }
+    ImGui::Text("FPostProcessSettings: %d bytes live, %zu in the SDK, %zu overridable properties (%.2f ms)",
+                layout->Size, sizeof(SDK::FPostProcessSettings), layout->Pairs, layout->BuildMs);
+    switch (GLayoutMode.load(std::memory_order_relaxed)) {
+    case LayoutMode::Compiled:
+        ImGui::TextUnformatted("Delivery: SDK offsets, every schema item matches");
+        break;
+    case LayoutMode::Live:
+        ImGui::TextColored(ImVec4(1.f, 0.8f, 0.2f, 1.f), "Delivery: live offsets, the SDK is out of date");
+        break;
+    case LayoutMode::Off:
+        ImGui::TextColored(ImVec4(1.f, 0.3f, 0.3f, 1.f),
+                           "Delivery: off, the BlueprintModifyPostProcess parameters moved");
+        break;
+    }
+    ImGui::Text("Schema items: %u ok, %u moved, %u retyped, %u missing", layout->Counts[0], layout->Counts[1],
+                layout->Counts[2], layout->Counts[3]);
+
+    if (layout->Counts[0] != kItemCount) {
+        constexpr auto flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY;
+        if (ImGui::BeginTable("##mismatches", 4, flags, ImVec2(0, 200))) {
+            ImGui::TableSetupScrollFreeze(0, 1);
+            ImGui::TableSetupColumn("Item");
+            ImGui::TableSetupColumn("Status");
+            ImGui::TableSetupColumn("SDK");
+            ImGui::TableSetupColumn("Live");
+            ImGui::TableHeadersRow();
+            for (std::size_t i = 0; i < kItemCount; ++i) {
+                const auto &item = layout->Items[i];
+                if (item.Status == FieldStatus::Ok)
+                    continue;
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(kItems[i].key);
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(FieldStatusName(item.Status));
+                ImGui::TableNextColumn();
+                ImGui::Text("@%04X", item.CompiledOffset);
+                ImGui::TableNextColumn();
+                if (item.Value)
+                    ImGui::Text("@%04X, %u bytes", item.Value->Offset, item.Value->Size);
+            }
+            ImGui::EndTable();
+        }
+    }
+
+    if (layout->Unlisted.empty() || !ImGui::TreeNode("##unlisted", "Not in the schema (%zu)", layout->Unlisted.size()))
+        return;
+    if (ImGui::Button("Copy names")) {
+        std::string names;
+        for (const auto &pair : layout->Unlisted)
+            names += (names.empty() ? "" : ", ") + pair.Value->Name;
+        ImGui::SetClipboardText(names.c_str());
+    }
+    if (ImGui::IsItemHovered())
+        ImGui::SetTooltip("Comma-separated, ready to paste into fields.h");
+    for (const auto &pair : layout->Unlisted)
+        ImGui::BulletText("%s @%04X", pair.Value->Name.c_str(), pair.Value->Offset);
+    ImGui::TreePop();
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace SDK {
+struct FPostProcessSettings;
+}
+
+// Live layout of FPostProcessSettings, built once from the game's own reflection data: every value property in
+// ChildProperties paired with its bOverride_ flag by name (reflect.h), and each schema item checked byte for byte
+// against what its compiled-in setter writes. While everything agrees, delivery keeps using the SDK's offsets. After a
+// game patch that moved, retyped or removed fields, delivery switches to writing through the live offsets instead,
+// items the game no longer has are dropped, and the blend-cache path, which copies the whole SDK struct, stays off.
+
+enum class LayoutMode : uint8_t {
+    Compiled, // SDK offsets; the live layout agrees, or has not been built yet
+    Live,     // writes go through the live offsets
+    Off,      // the BlueprintModifyPostProcess parameters themselves moved; nothing is delivered
+};
+
+enum class FieldStatus : uint8_t {
+    Ok,
+    Moved,   // same kind of value at another offset or bit
+    Retyped, // the game stores another type there; values are converted on the way in
+    Missing, // no such property, or no bOverride_ flag for it; never written
+};
+
+extern std::atomic<LayoutMode> GLayoutMode;
+
+// game thread, once the engine is up; later calls do nothing
+extern void BuildPostProcessLayout();
+// Ok until the layout is built (any thread)
+extern FieldStatus PostProcessFieldStatus(std::size_t idx);
+extern const char *FieldStatusName(FieldStatus status);
+
+// Live-mode counterparts of set_item, get_item and FPostProcessSettings |= (game thread). `own` is a struct in the
+// SDK layout, e.g. the snapshot's; like |=, the merge leaves the Gbx sub-structs to the sparse path.
+extern void WriteLiveItem(SDK::FPostProcessSettings &settings, std::size_t idx, bool enabled, float value);
+extern bool ReadLiveItem(const SDK::FPostProcessSettings &settings, std::size_t idx, float &value);
+extern void MergeLive(SDK::FPostProcessSettings &settings, const SDK::FPostProcessSettings &own);
+
+extern void DrawLayout();
@@ -0,0 +1,423 @@
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <immintrin.h>
+
+#include <imgui.h>
+#include <reshade.hpp>
+
+#include <easylogging++.h>
+
+#include "abtest.h"
+#include "addon.h"
+#include "curves.h"
+#include "mixer.h"
+#include "presets.h"
+#include "sweep.h"
+#include "zones.h"
+
+// =========================
+// Dense rows: one per slot, float items first and int items after, each part padded to whole SSE vectors
+// =========================
+static constexpr std::size_t kMixSlots = 8;
+static constexpr std::size_t kFloatItems = std::ranges::count(kItems, false, &item_desc::is_int);
+static constexpr std::size_t kFloatLanes = (kFloatItems + 3) / 4 * 4;
+static constexpr std::size_t kLanes = kFloatLanes + (kItemCount - kFloatItems + 3) / 4 * 4;
+
+// schema index -> lane
+static constexpr auto kLaneOf = [] {
+    std::array<uint16_t, kItemCount> lanes{};
+    std::size_t f = 0, n = kFloatLanes;
+    for (std::size_t i = 0; i < kItemCount; ++i)
+        lanes[i] = static_cast<uint16_t>(kItems[i].is_int ? n++ : f++);
+    return lanes;
+}();
+
+struct alignas(16) mix_row {
+    std::array<float, kLanes> values{};
+    std::array<float, kLanes> masks{}; // 1 where the preset enables the item
+};
+
+struct alignas(16) mix_result {
+    std::array<float, kLanes> values{};
+    std::array<float, kLanes> weights{}; // 0 where no weighted preset enables the item
+};
+
+static std::array<mix_row, kMixSlots> gRows{};
+static std::array<bool, kMixSlots> gGates{};
+static mix_result gResult{};
+
+// Every slot is visited, weighted 0 when empty or unresolved, so the slot loop has a fixed trip count and unrolls;
+// the float and int parts are separate loops so neither pays for the other's arithmetic.
+static void mix(const std::array<float, kMixSlots> &weights) {
+    const __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.f);
+    std::array<__m128, kMixSlots> w;
+    for (std::size_t k = 0; k < kMixSlots; ++k)
+        w[k] = _mm_set1_ps(weights[k]);
+
+    for (std::size_t i = 0; i < kFloatLanes; i += 4) {
+        __m128 sum = zero, total = zero;
+        [&]<std::size_t... K>(std::index_sequence<K...>) {
+            (
+                [&] {
+                    const __m128 weight = _mm_mul_ps(w[K], _mm_load_ps(&gRows[K].masks[i]));
+                    sum = _mm_add_ps(sum, _mm_mul_ps(weight, _mm_load_ps(&gRows[K].values[i])));
+                    total = _mm_add_ps(total, weight);
+                }(),
+                ...);
+        }(std::make_index_sequence<kMixSlots>{});
+        const __m128 covered = _mm_cmpgt_ps(total, zero);
+        const __m128 divisor = _mm_or_ps(_mm_and_ps(covered, total), _mm_andnot_ps(covered, one));
+        _mm_store_ps(&gResult.values[i], _mm_div_ps(sum, divisor));
+        _mm_store_ps(&gResult.weights[i], total);
+    }
+
+    for (std::size_t i = kFloatLanes; i < kLanes; i += 4) {
+        __m128 best = zero, pick = zero;
+        [&]<std::size_t... K>(std::index_sequence<K...>) {
+            (
+                [&] {
+                    const __m128 weight = _mm_mul_ps(w[K], _mm_load_ps(&gRows[K].masks[i]));
+                    const __m128 take = _mm_cmpgt_ps(weight, best);
+                    pick = _mm_or_ps(_mm_and_ps(take, _mm_load_ps(&gRows[K].values[i])), _mm_andnot_ps(take, pick));
+                    best = _mm_max_ps(best, weight);
+                }(),
+                ...);
+        }(std::make_index_sequence<kMixSlots>{});
+        _mm_store_ps(&gResult.values[i], pick);
+        _mm_store_ps(&gResult.weights[i], best);
+    }
+}
+
+// =========================
+// Slots and their drivers
+// =========================
+enum mix_driver : int { kManual = 0, kTimeOfDay = 1, kZone = 2 };
+
+struct mix_slot {
+    std::string preset; // by name, resolved against the library whenever its generation changes
+    int driver = kManual;
+    float weight = 1.f;  // manual weight, or the peak of the other drivers
+    float hour = 12.f;   // time of day: full weight at this hour,
+    float width = 6.f;   // falling to 0 this many hours away
+    std::array<char, 32> zone{};
+};
+
+static std::vector<mix_slot> gSlots;
+static std::array<bool, kMixSlots> gResolved{};
+static uint64_t gGeneration = ~uint64_t{0};
+
+static bool gMixing = false;
+static bool gDirty = false;
+static std::array<float, kMixSlots> gApplied{}; // weights of the last mix
+static float gMixNs = 0.f;                      // moving average over mixes
+static float gBenchmarkNs = 0.f;
+static uint64_t gMixes = 0;
+
+// what the overrides were when mixing started; items no slot enables fall back to it, and stopping restores it
+static bool gBaseEnabled = false;
+static std::array<bool, kItemCount> gBaseEnables{};
+static std::array<Value, kItemCount> gBaseValues{};
+
+static constexpr float kMinStep = 1e-3f; // smaller weight changes are not worth a publish
+
+static float slot_weight(const mix_slot &slot, float hour) {
+    switch (slot.driver) {
+    case kTimeOfDay: {
+        if (std::isnan(hour))
+            return 0.f;
+        const float distance = std::fabs(std::remainder(hour - slot.hour, 24.f));
+        return slot.weight * std::max(0.f, 1.f - distance / std::max(slot.width, 0.01f));
+    }
+    case kZone:
+        return slot.weight * zone_weight(slot.zone.data());
+    default:
+        return slot.weight;
+    }
+}
+
+static void resolve() {
+    gGeneration = preset_generation();
+    gRows = {};
+    gGates = {};
+    gResolved = {};
+    std::array<bool, kItemCount> enables{};
+    std::array<Value, kItemCount> values{};
+    for (std::size_t k = 0; k < gSlots.size(); ++k) {
+        std::size_t p = 0;
+        while (p < preset_count() && preset_name(p) != gSlots[k].preset)
+            ++p;
+        if (p == preset_count())
+            continue;
+        copy_preset(p, gGates[k], enables, values);
+        for (std::size_t i = 0; i < kItemCount; ++i) {
+            const auto lane = kLaneOf[i];
+            gRows[k].values[lane] =
+                kItems[i].is_int ? static_cast<float>(values[i].get<int>()) : values[i].get<float>();
+            gRows[k].masks[lane] = enables[i] ? 1.f : 0.f;
+        }
+        gResolved[k] = true;
+    }
+    gDirty = true;
+}
+
+static void publish_mix(const std::array<float, kMixSlots> &weights) {
+    const bool any = std::ranges::any_of(weights, [](float w) { return w > 0.f; });
+    gEnabled = any ? false : gBaseEnabled;
+    for (std::size_t k = 0; k < kMixSlots; ++k)
+        gEnabled |= weights[k] > 0.f && gGates[k];
+    for (std::size_t i = 0; i < kItemCount; ++i) {
+        const auto lane = kLaneOf[i];
+        gEnables[i] = any ? gResult.weights[lane] > 0.f : gBaseEnables[i];
+        if (!gEnables[i] || !any)
+            gValues[i] = gBaseValues[i];
+        else if (kItems[i].is_int)
+            gValues[i] = static_cast<int>(std::lround(gResult.values[lane]));
+        else
+            gValues[i] = gResult.values[lane];
+    }
+    apply_overrides();
+}
+
+void step_mixer() {
+    if (!gMixing)
+        return;
+    if (ab_test_running() || sweep_running()) {
+        gDirty = true; // remix once they hand the overrides back
+        return;
+    }
+    if (gGeneration != preset_generation())
+        resolve();
+
+    std::array<float, kMixSlots> weights{};
+    const float hour = current_hour();
+    for (std::size_t k = 0; k < gSlots.size(); ++k)
+        weights[k] = gResolved[k] ? std::max(slot_weight(gSlots[k], hour), 0.f) : 0.f;
+    bool moved = gDirty;
+    for (std::size_t k = 0; k < kMixSlots; ++k)
+        moved |= std::fabs(weights[k] - gApplied[k]) > kMinStep || (weights[k] > 0.f) != (gApplied[k] > 0.f);
+    if (!moved)
+        return;
+    gApplied = weights;
+    gDirty = false;
+
+    const auto start = std::chrono::steady_clock::now();
+    mix(weights);
+    const auto ns = std::chrono::duration<float, std::nano>(std::chrono::steady_clock::now() - start).count();
+    gMixNs = gMixes++ ? gMixNs * 0.9f + ns * 0.1f : ns;
+    publish_mix(weights);
+}
+
+bool mixer_running() { return gMixing; }
+
+static void set_mixing(bool on) {
+    if (on == gMixing)
+        return;
+    gMixing = on;
+    if (on) {
+        gBaseEnabled = gEnabled;
+        gBaseEnables = gEnables;
+        gBaseValues = gValues;
+        gDirty = true;
+        gGeneration = ~uint64_t{0};
+    } else {
+        gEnabled = gBaseEnabled;
+        gEnables = gBaseEnables;
+        gValues = gBaseValues;
+        apply_overrides();
+    }
+    LOG(INFO) << (on ? "Started" : "Stopped") << " mixing " << gSlots.size() << " presets";
+}
+
+// =========================
+// Preset storage
+// =========================
+// [untitled] Mixer=driver:weight:hour:width:Preset[\tZone] per slot, Mixer.Enabled=0/1
+static void save_mixer(reshade::api::effect_runtime *runtime) {
+    std::string packed;
+    for (const auto &slot : gSlots) {
+        if (!packed.empty())
+            packed.push_back('\0');
+        char buf[96]{};
+        auto end = std::to_chars(std::begin(buf), std::end(buf), slot.driver).ptr;
+        for (const float v : {slot.weight, slot.hour, slot.width}) {
+            *end++ = ':';
+            end = std::to_chars(end, std::end(buf), v).ptr;
+        }
+        *end++ = ':';
+        packed.append(buf, end) += slot.preset;
+        if (slot.driver == kZone)
+            packed.append("\t").append(slot.zone.data());
+    }
+    reshade::set_config_value(runtime, kSection, "Mixer", packed.c_str(), packed.size());
+    reshade::set_config_value(runtime, kSection, "Mixer.Enabled", gMixing ? "1" : "0");
+}
+
+static bool parse_slot(std::string_view entry, mix_slot &slot) {
+    std::array<float, 3> numbers{};
+    for (int n = -1; n < 3; ++n) {
+        const auto colon = entry.find(':');
+        if (colon == std::string_view::npos)
+            return false;
+        const auto field = entry.substr(0, colon);
+        const auto ok = n < 0 ? std::from_chars(field.data(), field.data() + field.size(), slot.driver).ec
+                              : std::from_chars(field.data(), field.data() + field.size(), numbers[n]).ec;
+        if (ok != std::errc())
+            return false;
+        entry.remove_prefix(colon + 1);
+    }
+    slot.weight = numbers[0];
+    slot.hour = numbers[1];
+    slot.width = numbers[2];
+    const auto tab = entry.find('\t');
+    slot.preset = entry.substr(0, tab);
+    if (tab != std::string_view::npos)
+        entry.substr(tab + 1).copy(slot.zone.data(), slot.zone.size() - 1);
+    return slot.driver >= kManual && slot.driver <= kZone && !slot.preset.empty();
+}
+
+void load_mixer(reshade::api::effect_runtime *runtime) {
+    std::size_t size = 0;
+    std::string packed;
+    if (reshade::get_config_value(runtime, kSection, "Mixer", nullptr, &size) && size > 0) {
+        packed.resize(size);
+        reshade::get_config_value(runtime, kSection, "Mixer", packed.data(), &size);
+        packed.resize(size);
+    }
+    gSlots.clear();
+    for (std::size_t pos = 0; pos < packed.size() && gSlots.size() < kMixSlots;) {
+        auto end = packed.find('\0', pos);
+        if (end == std::string::npos)
+            end = packed.size();
+        if (mix_slot slot; parse_slot(std::string_view(packed).substr(pos, end - pos), slot))
+            gSlots.push_back(std::move(slot));
+        pos = end + 1;
+    }
+
+    // the preset that was just loaded is the new base
+    char buf[8]{};
+    size = sizeof(buf);
+    const bool enabled = reshade::get_config_value(runtime, kSection, "Mixer.Enabled", buf, &size) && buf[0] == '1';
+    gMixing = false;
+    set_mixing(enabled);
+    LOG(INFO) << "Loaded " << gSlots.size() << " mixer slots";
+}
+
+// =========================
+// Overlay panel
+// =========================
+static void benchmark() {
+    constexpr int kRuns = 20000;
+    std::array<float, kMixSlots> weights;
+    weights.fill(1.f);
+    const auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < kRuns; ++r) {
+        weights[r % kMixSlots] = 0.5f + (r & 1) * 0.25f; // keep the calls from being folded together
+        mix(weights);
+    }
+    gBenchmarkNs = std::chrono::duration<float, std::nano>(std::chrono::steady_clock::now() - start).count() / kRuns;
+    gDirty = true; // the benchmark overwrote the last result
+    LOG(INFO) << "Mixing " << kMixSlots << " presets over " << kItemCount << " items takes " << gBenchmarkNs << " ns";
+}
+
+void draw_mixer(reshade::api::effect_runtime *runtime) {
+    bool changed = false;
+    ImGui::BeginDisabled(ab_test_running() || sweep_running());
+    if (bool mixing = gMixing; ImGui::Checkbox("Mix presets", &mixing)) {
+        set_mixing(mixing);
+        changed = true;
+    }
+    ImGui::EndDisabled();
+    ImGui::SameLine();
+    ImGui::TextDisabled("mix %.0f ns over %zu lanes, %llu mixes", gMixNs, kLanes,
+                        static_cast<unsigned long long>(gMixes));
+    ImGui::SameLine();
+    if (ImGui::SmallButton("Benchmark"))
+        benchmark();
+    if (gBenchmarkNs > 0.f) {
+        ImGui::SameLine();
+        ImGui::TextDisabled("%.0f ns per mix of %zu", gBenchmarkNs, kMixSlots);
+    }
+
+    const float hour = current_hour();
+    std::size_t remove = gSlots.size();
+    for (std::size_t k = 0; k < gSlots.size(); ++k) {
+        auto &slot = gSlots[k];
+        ImGui::PushID(static_cast<int>(k));
+        ImGui::Separator();
+        ImGui::SetNextItemWidth(200.f);
+        if (ImGui::BeginCombo("##preset", slot.preset.c_str())) {
+            for (std::size_t p = 0; p < preset_count(); ++p) {
+                const std::string name(preset_name(p));
+                if (ImGui::Selectable(name.c_str(), name == slot.preset)) {
+                    slot.preset = name;
+                    gGeneration = ~uint64_t{0};
+                    changed = true;
+                }
+            }
+            ImGui::EndCombo();
+        }
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(120.f);
+        changed |= ImGui::Combo("##driver", &slot.driver, "Manual\0Time of day\0Zone\0");
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(150.f);
+        ImGui::SliderFloat("##weight", &slot.weight, 0.f, 1.f, "weight %.2f");
+        changed |= ImGui::IsItemDeactivatedAfterEdit();
+        ImGui::SameLine();
+        if (!gResolved[k] && gMixing)
+            ImGui::TextColored(ImVec4(1.f, 0.6f, 0.2f, 1.f), "not in library");
+        else
+            ImGui::TextDisabled("-> %.2f", gMixing ? gApplied[k] : slot_weight(slot, hour));
+        ImGui::SameLine();
+        if (ImGui::SmallButton("x"))
+            remove = k;
+
+        if (slot.driver == kTimeOfDay) {
+            ImGui::SetNextItemWidth(150.f);
+            ImGui::InputFloat("Peak hour", &slot.hour, 0.25f, 1.f, "%05.2f");
+            changed |= ImGui::IsItemDeactivatedAfterEdit();
+            ImGui::SameLine();
+            ImGui::SetNextItemWidth(150.f);
+            ImGui::InputFloat("Width (h)", &slot.width, 0.25f, 1.f, "%.2f");
+            changed |= ImGui::IsItemDeactivatedAfterEdit();
+            slot.hour = std::clamp(slot.hour, 0.f, 24.f);
+            slot.width = std::clamp(slot.width, 0.25f, 12.f);
+        } else if (slot.driver == kZone) {
+            ImGui::SetNextItemWidth(200.f);
+            ImGui::InputText("Zone", slot.zone.data(), slot.zone.size());
+            changed |= ImGui::IsItemDeactivatedAfterEdit();
+        }
+        ImGui::PopID();
+    }
+    if (remove < gSlots.size()) {
+        gSlots.erase(gSlots.begin() + static_cast<std::ptrdiff_t>(remove));
+        gGeneration = ~uint64_t{0};
+        changed = true;
+    }
+
+    ImGui::Separator();
+    ImGui::BeginDisabled(gSlots.size() >= kMixSlots || preset_count() == 0);
+    if (ImGui::Button("Add slot")) {
+        gSlots.push_back({std::string(preset_name(0))});
+        gGeneration = ~uint64_t{0};
+        changed = true;
+    }
+    ImGui::EndDisabled();
+    if (preset_count() == 0) {
+        ImGui::SameLine();
+        ImGui::TextDisabled("the preset library is empty");
+    }
+
+    if (changed) {
+        gDirty = true;
+        save_mixer(runtime);
+    }
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+namespace reshade::api {
+struct effect_runtime;
+}
+
+// Preset mixer: blends up to eight presets from the library (presets.h) into the override arrays. Float items are
+// averaged by weight over the presets that enable them, int and enum items take the value of the heaviest such preset,
+// and an item (or the global gate) is on when any weighted preset turns it on. A slot's weight is set by hand, or
+// follows the time of day (curves.h) or a named zone around the camera (zones.h). The presets are kept as dense rows
+// so a mix is one SSE pass over all items, and the result goes out through apply_overrides() only when a weight
+// moved. Everything runs on the render thread.
+
+void load_mixer(reshade::api::effect_runtime *runtime);
+// re-weighs and, if anything moved, mixes and publishes; called from reshade_present
+void step_mixer();
+// the mixer owns the override arrays while this is true, and restores what it found when it stops
+bool mixer_running();
+
+void draw_mixer(reshade::api::effect_runtime *runtime);
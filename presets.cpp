@@ -0,0 +1,495 @@
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <windows.h>
+
+#include <imgui.h>
+#include <reshade.hpp>
+
+#include <easylogging++.h>
+
+#include "abtest.h"
+#include "addon.h"
+#include "cvars.h"
+#include "governor.h"
+#include "journal.h"
+#include "mixer.h"
+#include "presets.h"
+#include "sweep.h"
+
+// =========================
+// File format: header, entries, enable bitsets, values, item keys, string blob; little-endian, used in place from
+// the mapping
+// =========================
+static constexpr uint32_t kLibraryMagic = 0x4c505455; // "UTPL"
+static constexpr uint32_t kLibraryVersion = 1;
+static constexpr std::size_t kWords = (kItemCount + 63) / 64;
+
+struct library_header {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t schema_hash; // kSchemaHash of the build that wrote the file
+    uint32_t item_count;
+    uint32_t preset_count;
+    uint32_t words;     // 64-bit words per enable bitset
+    uint32_t blob_size; // preset names and item keys, unterminated
+};
+
+enum library_flags : uint16_t { kGate = 1 }; // the preset's global Enabled
+
+struct library_entry {
+    uint32_t name; // offset into the blob
+    uint16_t name_length;
+    uint16_t flags;
+};
+
+// the schema the bitsets and values are aligned to, for migrating a file written by another build
+struct library_key {
+    uint32_t key; // offset into the blob
+    uint16_t key_length;
+    uint16_t is_int;
+};
+
+static_assert(sizeof(library_header) == 32 && sizeof(library_entry) == 8 && sizeof(library_key) == 8);
+static_assert(sizeof(Value) == sizeof(uint32_t));
+
+struct library_map {
+    std::vector<std::byte> owned; // built in memory and not on disk yet
+    const void *view = nullptr;   // or mapped from the file
+    library_header header{};
+    std::span<const library_entry> entries;
+    std::span<const uint64_t> bits;   // preset_count * words
+    std::span<const uint32_t> values; // preset_count * item_count, raw Value bits
+    std::span<const library_key> keys;
+    std::string_view blob;
+
+    library_map() = default;
+    library_map(const library_map &) = delete;
+    library_map &operator=(const library_map &) = delete;
+    ~library_map() {
+        if (view)
+            UnmapViewOfFile(view);
+    }
+
+    // usable in place: bitsets and values line up with this build's schema indices
+    bool current() const { return header.schema_hash == kSchemaHash && header.item_count == kItemCount; }
+    std::string_view name(std::size_t p) const { return blob.substr(entries[p].name, entries[p].name_length); }
+    bool enabled(std::size_t p, std::size_t item) const { return bits[p * header.words + item / 64] >> item % 64 & 1; }
+
+    bool parse(const std::byte *data, std::size_t size) {
+        if (size < sizeof(header))
+            return false;
+        std::memcpy(&header, data, sizeof(header));
+        const std::size_t presets = header.preset_count, items = header.item_count;
+        const auto need = sizeof(header) + presets * sizeof(library_entry) + presets * header.words * sizeof(uint64_t) +
+                          presets * items * sizeof(uint32_t) + items * sizeof(library_key) + header.blob_size;
+        if (header.magic != kLibraryMagic || header.version != kLibraryVersion || header.words != (items + 63) / 64 ||
+            size < need)
+            return false;
+        auto at = data + sizeof(header);
+        entries = {reinterpret_cast<const library_entry *>(at), presets};
+        at += entries.size_bytes();
+        bits = {reinterpret_cast<const uint64_t *>(at), presets * header.words};
+        at += bits.size_bytes();
+        values = {reinterpret_cast<const uint32_t *>(at), presets * items};
+        at += values.size_bytes();
+        keys = {reinterpret_cast<const library_key *>(at), items};
+        at += keys.size_bytes();
+        blob = {reinterpret_cast<const char *>(at), header.blob_size};
+
+        // a corrupt file must not send a lookup out of bounds
+        for (const auto &entry : entries)
+            if (entry.name + std::size_t{entry.name_length} > blob.size())
+                return false;
+        for (const auto &key : keys)
+            if (key.key + std::size_t{key.key_length} > blob.size())
+                return false;
+        return true;
+    }
+};
+
+static std::unique_ptr<library_map> map_file(const std::filesystem::path &path) {
+    auto file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return nullptr;
+    LARGE_INTEGER size{};
+    GetFileSizeEx(file, &size);
+    auto mapping = size.QuadPart > 0 ? CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+    CloseHandle(file);
+    if (!mapping)
+        return nullptr;
+    auto view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping); // the view keeps the section alive
+    if (!view)
+        return nullptr;
+    auto map = std::make_unique<library_map>();
+    map->view = view;
+    if (!map->parse(static_cast<const std::byte *>(view), static_cast<std::size_t>(size.QuadPart))) {
+        LOG(ERROR) << "Preset library " << path.string() << " is not a valid version " << kLibraryVersion << " file";
+        return nullptr;
+    }
+    return map;
+}
+
+// =========================
+// Editing and building (render thread)
+// =========================
+struct preset_edit {
+    std::string name;
+    bool gate = false;
+    std::array<bool, kItemCount> enables{};
+    std::array<Value, kItemCount> values{};
+};
+
+static std::vector<preset_edit> gPresets;
+static std::unique_ptr<library_map> gMap; // always current(); a migrated file is rebuilt in memory
+static std::filesystem::path gPath;
+static bool gUnsaved = false;
+static std::size_t gActive = std::numeric_limits<std::size_t>::max();
+static float gSwitchUs = 0.f;
+static uint64_t gGeneration = 0;
+
+static std::vector<std::byte> build_image(const std::vector<preset_edit> &presets) {
+    std::string blob;
+    std::vector<library_entry> entries;
+    std::vector<uint64_t> bits(presets.size() * kWords);
+    std::vector<uint32_t> values(presets.size() * kItemCount);
+    std::vector<library_key> keys;
+    for (std::size_t p = 0; p < presets.size(); ++p) {
+        const auto &preset = presets[p];
+        const auto length = std::min<std::size_t>(preset.name.size(), std::numeric_limits<uint16_t>::max());
+        entries.push_back({static_cast<uint32_t>(blob.size()), static_cast<uint16_t>(length),
+                           static_cast<uint16_t>(preset.gate ? kGate : 0)});
+        blob.append(preset.name, 0, length);
+        for (std::size_t i = 0; i < kItemCount; ++i) {
+            if (preset.enables[i])
+                bits[p * kWords + i / 64] |= uint64_t{1} << i % 64;
+            values[p * kItemCount + i] = std::bit_cast<uint32_t>(preset.values[i]);
+        }
+    }
+    for (const auto &item : kItems) {
+        const std::string_view key = item.key;
+        keys.push_back({static_cast<uint32_t>(blob.size()), static_cast<uint16_t>(key.size()),
+                        static_cast<uint16_t>(item.is_int)});
+        blob += key;
+    }
+
+    const library_header header{kLibraryMagic,
+                                kLibraryVersion,
+                                kSchemaHash,
+                                static_cast<uint32_t>(kItemCount),
+                                static_cast<uint32_t>(entries.size()),
+                                static_cast<uint32_t>(kWords),
+                                static_cast<uint32_t>(blob.size())};
+    std::vector<std::byte> image(sizeof(header) + entries.size() * sizeof(library_entry) +
+                                 bits.size() * sizeof(uint64_t) + values.size() * sizeof(uint32_t) +
+                                 keys.size() * sizeof(library_key) + blob.size());
+    auto at = image.data();
+    auto put = [&](const void *data, std::size_t size) {
+        if (size)
+            std::memcpy(at, data, size);
+        at += size;
+    };
+    put(&header, sizeof(header));
+    put(entries.data(), entries.size() * sizeof(library_entry));
+    put(bits.data(), bits.size() * sizeof(uint64_t));
+    put(values.data(), values.size() * sizeof(uint32_t));
+    put(keys.data(), keys.size() * sizeof(library_key));
+    put(blob.data(), blob.size());
+    return image;
+}
+
+// by position when the schema matches, otherwise by key; items the file does not know stay off
+static std::vector<preset_edit> decode(const library_map &map) {
+    std::vector<std::size_t> index(map.header.item_count);
+    std::vector<bool> is_int(map.header.item_count);
+    for (std::size_t k = 0; k < index.size(); ++k) {
+        const auto &key = map.keys[k];
+        index[k] = map.current() ? k : find_item(map.blob.substr(key.key, key.key_length));
+        is_int[k] = key.is_int != 0;
+    }
+
+    std::vector<preset_edit> presets(map.entries.size());
+    for (std::size_t p = 0; p < presets.size(); ++p) {
+        auto &preset = presets[p];
+        preset.name = map.name(p);
+        preset.gate = map.entries[p].flags & kGate;
+        for (std::size_t k = 0; k < index.size(); ++k) {
+            const auto i = index[k];
+            if (i >= kItemCount)
+                continue;
+            const auto raw = map.values[p * map.header.item_count + k];
+            preset.enables[i] = map.enabled(p, k);
+            if (is_int[k] == kItems[i].is_int)
+                preset.values[i] = std::bit_cast<Value>(raw);
+            else if (kItems[i].is_int)
+                preset.values[i] = static_cast<int>(std::lround(std::bit_cast<float>(raw)));
+            else
+                preset.values[i] = static_cast<float>(std::bit_cast<int>(raw));
+        }
+    }
+    return presets;
+}
+
+static void rebuild() {
+    auto map = std::make_unique<library_map>();
+    map->owned = build_image(gPresets);
+    map->parse(map->owned.data(), map->owned.size());
+    gMap = std::move(map);
+    gUnsaved = true;
+    ++gGeneration;
+}
+
+static void save_library() {
+    if (!gMap || gMap->owned.empty())
+        return;
+    auto temp = gPath;
+    temp += ".tmp";
+    std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char *>(gMap->owned.data()), static_cast<std::streamsize>(gMap->owned.size()));
+    out.close();
+    if (!out) {
+        LOG(ERROR) << "Failed to write " << temp.string();
+        return;
+    }
+    // nothing but this file maps the library, and an unsaved map is never the mapped file itself
+    if (!MoveFileExW(temp.c_str(), gPath.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+        LOG(ERROR) << "Failed to replace " << gPath.string() << " (error " << GetLastError() << ")";
+        return;
+    }
+    if (auto mapped = map_file(gPath))
+        gMap = std::move(mapped);
+    gUnsaved = false;
+    LOG(INFO) << "Saved " << gPresets.size() << " presets to " << gPath.string();
+}
+
+void load_presets(reshade::api::effect_runtime *runtime) {
+    char name[260]{};
+    std::size_t size = sizeof(name);
+    if (!reshade::get_config_value(runtime, kSection, "Presets.File", name, &size) || size <= 1)
+        std::strcpy(name, "untitled-presets.bin");
+    gPath = std::filesystem::current_path() / name;
+    gMap = map_file(gPath);
+    gPresets = gMap ? decode(*gMap) : std::vector<preset_edit>();
+    gActive = std::numeric_limits<std::size_t>::max();
+    gUnsaved = false;
+    ++gGeneration;
+    if (gMap && !gMap->current()) {
+        LOG(WARNING) << "Preset library " << gPath.string() << " was written against another schema ("
+                     << gMap->header.item_count << " items), migrated by key; save to keep the migration";
+        rebuild();
+    }
+    LOG(INFO) << "Loaded " << gPresets.size() << " presets from " << gPath.string();
+}
+
+// =========================
+// Switching and mixer access (render thread)
+// =========================
+uint64_t preset_generation() { return gGeneration; }
+std::size_t preset_count() { return gMap ? gPresets.size() : 0; }
+std::string_view preset_name(std::size_t p) { return gPresets[p].name; }
+
+void copy_preset(std::size_t p, bool &gate, std::array<bool, kItemCount> &enables,
+                 std::array<Value, kItemCount> &values) {
+    const auto &map = *gMap;
+    gate = map.entries[p].flags & kGate;
+    for (std::size_t i = 0; i < kItemCount; ++i)
+        enables[i] = map.enabled(p, i);
+    std::memcpy(values.data(), map.values.data() + p * kItemCount, sizeof(values));
+}
+
+static void activate(std::size_t p) {
+    const auto start = std::chrono::steady_clock::now();
+    const bool was_enabled = gEnabled;
+    copy_preset(p, gEnabled, gEnables, gValues);
+    reset_governor(); // its saved values belong to the state just replaced
+    apply_overrides();
+    gSwitchUs = std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - start).count();
+    gActive = p;
+    journal_state("Preset " + gPresets[p].name);
+
+    if (gEnabled != was_enabled) {
+        if (gEnabled)
+            apply_cvars();
+        else
+            revert_cvars();
+    }
+    LOG(INFO) << "Switched to preset " << gPresets[p].name << " in " << gSwitchUs << " us";
+}
+
+// =========================
+// Converting from the ini format: the [untitled] section of a ReShade preset, read the way load_all_from_preset
+// reads it, except that absent values are 0 rather than whatever was loaded before
+// =========================
+static std::string_view trim(std::string_view s) {
+    const auto first = s.find_first_not_of(" \t\r");
+    if (first == std::string_view::npos)
+        return {};
+    return s.substr(first, s.find_last_not_of(" \t\r") - first + 1);
+}
+
+static std::optional<preset_edit> read_ini(const std::filesystem::path &path) {
+    std::ifstream in(path);
+    std::vector<std::pair<std::string, std::string>> pairs;
+    bool in_section = false, found = false;
+    for (std::string line; std::getline(in, line);) {
+        const auto text = trim(line);
+        if (text.starts_with('[')) {
+            in_section = text.ends_with(']') && text.substr(1, text.size() - 2) == kSection;
+            found |= in_section;
+        } else if (const auto eq = text.find('='); in_section && eq != std::string_view::npos) {
+            pairs.emplace_back(trim(text.substr(0, eq)), trim(text.substr(eq + 1)));
+        }
+    }
+    if (!found)
+        return std::nullopt;
+
+    preset_edit preset;
+    preset.name = path.stem().string();
+    for (const auto &[key, value] : pairs) {
+        if (key == "Enabled") {
+            preset.gate = value.starts_with('1');
+            continue;
+        }
+        const auto dot = key.rfind('.');
+        const auto item = dot == std::string::npos ? kItemCount : find_item(std::string_view(key).substr(0, dot));
+        if (item >= kItemCount)
+            continue;
+        const auto suffix = std::string_view(key).substr(dot);
+        if (suffix == Suffix_Enabled.c_str()) {
+            preset.enables[item] = value.starts_with('1');
+        } else if (suffix == Suffix_Value.c_str()) {
+            if (kItems[item].is_int) {
+                int v = 0;
+                std::from_chars(value.data(), value.data() + value.size(), v);
+                preset.values[item] = v;
+            } else {
+                float v = 0.f;
+                std::from_chars(value.data(), value.data() + value.size(), v);
+                preset.values[item] = v;
+            }
+        }
+    }
+    return preset;
+}
+
+// replaces a preset of the same name, so converting a folder again picks up edits to its ini files
+static void put_preset(preset_edit preset) {
+    const auto it = std::ranges::find(gPresets, preset.name, &preset_edit::name);
+    if (it != gPresets.end())
+        *it = std::move(preset);
+    else
+        gPresets.push_back(std::move(preset));
+}
+
+static void import_folder(const std::filesystem::path &folder) {
+    std::size_t count = 0;
+    std::error_code ec;
+    for (const auto &entry : std::filesystem::directory_iterator(folder, ec)) {
+        if (!entry.is_regular_file() || entry.path().extension() != ".ini")
+            continue;
+        if (auto preset = read_ini(entry.path())) {
+            put_preset(std::move(*preset));
+            ++count;
+        }
+    }
+    if (ec)
+        LOG(ERROR) << "Failed to list " << folder.string() << ": " << ec.message();
+    LOG(INFO) << "Converted " << count << " ini presets from " << folder.string();
+    if (count)
+        rebuild();
+}
+
+// =========================
+// Overlay panel
+// =========================
+void draw_presets(reshade::api::effect_runtime *runtime) {
+    ImGui::TextDisabled("%s", gPath.string().c_str());
+    ImGui::TextDisabled("%zu presets, schema %016llx, last switch %.0f us", gPresets.size(),
+                        static_cast<unsigned long long>(kSchemaHash), gSwitchUs);
+
+    // a running A/B test, sweep or mix owns the override state
+    ImGui::BeginDisabled(ab_test_running() || sweep_running() || mixer_running());
+    constexpr auto flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY;
+    if (gMap && !gPresets.empty() && ImGui::BeginTable("##presets", 3, flags, ImVec2(0, 200))) {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("Preset");
+        ImGui::TableSetupColumn("Gate");
+        ImGui::TableSetupColumn("Overrides");
+        ImGui::TableHeadersRow();
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(gPresets.size()));
+        while (clipper.Step()) {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+                const auto p = static_cast<std::size_t>(row);
+                ImGui::PushID(row);
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                if (ImGui::Selectable(gPresets[p].name.c_str(), gActive == p, ImGuiSelectableFlags_SpanAllColumns))
+                    activate(p);
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(gPresets[p].gate ? "on" : "off");
+                ImGui::TableNextColumn();
+                ImGui::Text("%zu", static_cast<std::size_t>(std::ranges::count(gPresets[p].enables, true)));
+                ImGui::PopID();
+            }
+        }
+        ImGui::EndTable();
+    }
+    ImGui::EndDisabled();
+
+    static std::array<char, 64> name{};
+    ImGui::SetNextItemWidth(200.f);
+    ImGui::InputTextWithHint("##name", "name", name.data(), name.size());
+    ImGui::SameLine();
+    ImGui::BeginDisabled(name[0] == '\0');
+    if (ImGui::Button("Add current")) {
+        put_preset({name.data(), gEnabled, gEnables, gValues});
+        rebuild();
+    }
+    ImGui::EndDisabled();
+    ImGui::SameLine();
+    ImGui::BeginDisabled(gActive >= gPresets.size());
+    if (ImGui::Button("Delete selected")) {
+        gPresets.erase(gPresets.begin() + static_cast<std::ptrdiff_t>(gActive));
+        gActive = std::numeric_limits<std::size_t>::max();
+        rebuild();
+    }
+    ImGui::EndDisabled();
+
+    static std::array<char, 260> folder{};
+    if (folder[0] == '\0')
+        std::strncpy(folder.data(), std::filesystem::current_path().string().c_str(), folder.size() - 1);
+    ImGui::SetNextItemWidth(400.f);
+    ImGui::InputText("##folder", folder.data(), folder.size());
+    ImGui::SameLine();
+    if (ImGui::Button("Convert .ini presets"))
+        import_folder(folder.data());
+
+    ImGui::BeginDisabled(!gUnsaved);
+    if (ImGui::Button("Save"))
+        save_library();
+    ImGui::EndDisabled();
+    ImGui::SameLine();
+    if (ImGui::Button("Reload"))
+        load_presets(runtime);
+    ImGui::SameLine();
+    if (ImGui::Button("Write current to ReShade preset"))
+        save_overrides(runtime);
+    if (ImGui::IsItemHovered())
+        ImGui::SetTooltip("Switching only changes the running overrides; this stores them in the ReShade preset");
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "schema.h"
+
+namespace reshade::api {
+struct effect_runtime;
+}
+
+// Preset library: many named override sets in one flat binary file ([untitled] Presets.File, next to the game
+// executable), memory-mapped read-only. Each preset is a gate flag, a packed enable bitset and one value per item,
+// both in schema index order, so switching copies straight into the override arrays and publishes a single snapshot
+// with no ini parsing. The file records the schema hash it was written against; a library from another schema is
+// migrated by item key on load and rewritten on the next save. Curves, zones, the view channel and console variables
+// stay with the ReShade preset.
+
+void load_presets(reshade::api::effect_runtime *runtime);
+void draw_presets(reshade::api::effect_runtime *runtime);
+
+// library access for the mixer (mixer.h), render thread. The generation changes whenever presets are added, removed,
+// converted or reloaded; indices and names are only stable within one generation.
+uint64_t preset_generation();
+std::size_t preset_count();
+std::string_view preset_name(std::size_t p);
+void copy_preset(std::size_t p, bool &gate, std::array<bool, kItemCount> &enables,
+                 std::array<Value, kItemCount> &values);
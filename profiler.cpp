@@ -0,0 +1,379 @@
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <imgui.h>
+
+#include <easylogging++.h>
+
+#include <SDK/CoreUObject_classes.hpp>
+
+#include "profiler.h"
+
+std::atomic_bool GProfilerEnabled = false;
+std::atomic<ProfilerSampling> GProfilerSampling = ProfilerSampling::EveryCall;
+std::atomic<uint32_t> GProfilerSamplePeriod = 16;
+std::atomic<float> GProfilerBudget = 0.005f;
+thread_local ProfilerSampler TProfilerSampler;
+
+namespace {
+
+// =========================
+// Per-thread tables: single writer (the owning thread), merged on demand by the overlay
+// =========================
+constexpr std::size_t kSlotBits = 11;
+constexpr std::size_t kSlots = std::size_t{1} << kSlotBits; // open addressing, linear probing
+constexpr std::size_t kBuckets = 26; // bucket 0: < 64 ticks, bucket k: [2^(k+5), 2^(k+6)) ticks
+
+struct alignas(64) Slot {
+    std::atomic<SDK::UFunction *> Function = nullptr;
+    std::atomic<uint64_t> Calls = 0;
+    std::atomic<uint64_t> Ticks = 0;
+    std::array<std::atomic<uint64_t>, kBuckets> Buckets{}; // 64-bit: sampled calls add the period as weight
+};
+static_assert(sizeof(Slot) == 256);
+
+struct alignas(64) Table {
+    std::atomic<uint32_t> Epoch = 0;
+    std::atomic<uint32_t> Period = 1;  // owner's current sample period, for display
+    std::atomic<uint64_t> Dropped = 0; // calls that found the table full
+    std::array<Slot, kSlots> Slots;
+};
+
+std::mutex GTablesMutex;
+std::vector<std::unique_ptr<Table>> GTables;
+std::atomic<uint32_t> GEpoch = 0; // bumped by ProfilerReset; owners clear their table lazily
+thread_local Table *TTable = nullptr;
+
+// owner-only increment: no RMW needed since every table has exactly one writer
+template <typename T> void Bump(std::atomic<T> &counter, T value) {
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+Table *LocalTable() {
+    if (!TTable) [[unlikely]] {
+        auto table = std::make_unique<Table>();
+        table->Epoch.store(GEpoch.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        std::lock_guard guard(GTablesMutex);
+        TTable = GTables.emplace_back(std::move(table)).get();
+    }
+    return TTable;
+}
+
+void Clear(Table &table) {
+    for (auto &slot : table.Slots) {
+        slot.Function.store(nullptr, std::memory_order_relaxed);
+        slot.Calls.store(0, std::memory_order_relaxed);
+        slot.Ticks.store(0, std::memory_order_relaxed);
+        for (auto &bucket : slot.Buckets)
+            bucket.store(0, std::memory_order_relaxed);
+    }
+    table.Dropped.store(0, std::memory_order_relaxed);
+}
+
+void Update(Slot &slot, uint64_t ticks, uint32_t weight) {
+    Bump<uint64_t>(slot.Calls, weight);
+    Bump<uint64_t>(slot.Ticks, ticks * weight);
+    const auto bucket = std::min<std::size_t>(std::bit_width(ticks >> 6), kBuckets - 1);
+    Bump<uint64_t>(slot.Buckets[bucket], weight);
+}
+
+// =========================
+// Sampling controller
+// =========================
+constexpr uint32_t kMaxPeriod = 1u << 16;
+constexpr uint64_t kWindowTicks = uint64_t{1} << 26; // ~20 ms at 3 GHz
+constexpr uint64_t kTimerTicks = 50;                  // the two rdtsc around the sampled GProcessEvent
+
+uint32_t NextPeriod(ProfilerSampler &sampler, uint64_t entered) {
+    switch (GProfilerSampling.load(std::memory_order_relaxed)) {
+    case ProfilerSampling::EveryCall:
+        return 1;
+    case ProfilerSampling::EveryNth:
+        return std::clamp<uint32_t>(GProfilerSamplePeriod.load(std::memory_order_relaxed), 1, kMaxPeriod);
+    case ProfilerSampling::Adaptive:
+        break;
+    }
+    // double the period while this thread's instrumentation exceeds the budget, halve it while well below
+    const auto now = ProfilerNow();
+    sampler.WindowOverhead += now - entered + kTimerTicks;
+    auto period = sampler.Period;
+    if (now - sampler.WindowStart >= kWindowTicks) {
+        const auto elapsed = static_cast<double>(now - sampler.WindowStart);
+        const auto ratio = static_cast<double>(sampler.WindowOverhead) / elapsed;
+        const auto budget = static_cast<double>(GProfilerBudget.load(std::memory_order_relaxed));
+        if (ratio > budget && period < kMaxPeriod)
+            period *= 2;
+        else if (ratio < budget / 4.0 && period > 1)
+            period /= 2;
+        sampler.WindowStart = now;
+        sampler.WindowOverhead = 0;
+    }
+    return period;
+}
+
+// rdtsc -> microseconds, calibrated against steady_clock since the first call
+double TicksPerMicrosecond() {
+    static const auto anchorTicks = ProfilerNow();
+    static const auto anchorTime = std::chrono::steady_clock::now();
+    static double cached = 0.0;
+    const auto elapsed =
+        std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - anchorTime).count();
+    if (elapsed > 1000.0)
+        cached = static_cast<double>(ProfilerNow() - anchorTicks) / elapsed;
+    return cached > 0.0 ? cached : 1000.0; // until calibrated, assume 1 GHz
+}
+
+using Histogram = std::array<uint64_t, kBuckets>;
+
+double Percentile(const Histogram &histogram, uint64_t calls, double q) {
+    const double rank = q * static_cast<double>(calls);
+    double seen = 0.0;
+    for (std::size_t k = 0; k < kBuckets; ++k) {
+        const auto count = static_cast<double>(histogram[k]);
+        if (count > 0.0 && seen + count >= rank) {
+            const double lo = k == 0 ? 0.0 : static_cast<double>(uint64_t{1} << (k + 5));
+            const double hi = static_cast<double>(uint64_t{1} << (k + 6));
+            return lo + (hi - lo) * ((rank - seen) / count);
+        }
+        seen += count;
+    }
+    return 0.0;
+}
+
+// =========================
+// Function names: taken by the recording thread while the function is running, so a Blueprint function freed by a
+// level unload is never dereferenced later. Keyed by address and checked against the object index, since a freed
+// function's address can come back as another one.
+// =========================
+struct FunctionName {
+    int32_t Index;
+    int32_t OuterIndex;
+    std::string Name;
+};
+
+std::mutex GNamesMutex;
+std::unordered_map<SDK::UFunction *, FunctionName> GNames;
+
+// once per function per thread table, when it claims a slot
+void RememberName(SDK::UFunction *function) {
+    auto object = reinterpret_cast<SDK::UObject *>(function);
+    std::lock_guard guard(GNamesMutex);
+    auto [it, inserted] = GNames.try_emplace(function);
+    if (inserted || it->second.Index != object->Index)
+        it->second = {object->Index, object->Outer ? object->Outer->Index : -1, object->GetFullName()};
+}
+
+FunctionName NameOf(SDK::UFunction *function) {
+    std::lock_guard guard(GNamesMutex);
+    const auto it = GNames.find(function);
+    return it != GNames.end() ? it->second : FunctionName{-1, -1, "?"};
+}
+
+} // namespace
+
+void ProfilerRecord(SDK::UFunction *function, uint64_t ticks, uint32_t weight) {
+    const auto entered = ProfilerNow();
+    auto &sampler = TProfilerSampler;
+    auto table = LocalTable();
+    if (const auto epoch = GEpoch.load(std::memory_order_relaxed);
+        table->Epoch.load(std::memory_order_relaxed) != epoch) [[unlikely]] {
+        Clear(*table);
+        table->Epoch.store(epoch, std::memory_order_release);
+    }
+
+    const auto hash = (reinterpret_cast<uintptr_t>(function) >> 4) * 0x9E3779B97F4A7C15ull;
+    auto index = static_cast<std::size_t>(hash >> (64 - kSlotBits));
+    bool recorded = false;
+    for (std::size_t probe = 0; probe < kSlots && !recorded; ++probe, index = (index + 1) & (kSlots - 1)) {
+        auto &slot = table->Slots[index];
+        const auto current = slot.Function.load(std::memory_order_relaxed);
+        if (current == function) {
+            Update(slot, ticks, weight);
+            recorded = true;
+        } else if (!current) {
+            RememberName(function);
+            Update(slot, ticks, weight);
+            slot.Function.store(function, std::memory_order_release); // publish after the counters
+            recorded = true;
+        }
+    }
+    if (!recorded)
+        Bump<uint64_t>(table->Dropped, weight);
+
+    const auto period = NextPeriod(sampler, entered);
+    sampler.Period = period;
+    table->Period.store(period, std::memory_order_relaxed);
+}
+
+std::vector<ProfilerRow> ProfilerCollect(uint64_t *dropped) {
+    struct Merged {
+        uint64_t Calls = 0;
+        uint64_t Ticks = 0;
+        Histogram Buckets{};
+    };
+    std::unordered_map<SDK::UFunction *, Merged> merged;
+    uint64_t lost = 0;
+    {
+        std::lock_guard guard(GTablesMutex);
+        const auto epoch = GEpoch.load(std::memory_order_acquire);
+        for (auto &table : GTables) {
+            if (table->Epoch.load(std::memory_order_acquire) != epoch)
+                continue; // owner has not cleared since the last reset
+            lost += table->Dropped.load(std::memory_order_relaxed);
+            for (auto &slot : table->Slots) {
+                auto function = slot.Function.load(std::memory_order_acquire);
+                if (!function)
+                    continue;
+                auto &m = merged[function];
+                m.Calls += slot.Calls.load(std::memory_order_relaxed);
+                m.Ticks += slot.Ticks.load(std::memory_order_relaxed);
+                for (std::size_t k = 0; k < kBuckets; ++k)
+                    m.Buckets[k] += slot.Buckets[k].load(std::memory_order_relaxed);
+            }
+        }
+    }
+    if (dropped)
+        *dropped = lost;
+
+    const double tpu = TicksPerMicrosecond();
+    std::vector<ProfilerRow> rows;
+    rows.reserve(merged.size());
+    for (auto &[function, m] : merged) {
+        if (m.Calls == 0)
+            continue;
+        const double total = static_cast<double>(m.Ticks) / tpu;
+        auto name = NameOf(function);
+        rows.push_back({function, name.OuterIndex, std::move(name.Name), m.Calls, total,
+                        total / static_cast<double>(m.Calls), Percentile(m.Buckets, m.Calls, 0.50) / tpu,
+                        Percentile(m.Buckets, m.Calls, 0.99) / tpu});
+    }
+    std::ranges::sort(rows, std::greater{}, &ProfilerRow::TotalUs);
+    return rows;
+}
+
+void ProfilerReset() { GEpoch.fetch_add(1, std::memory_order_acq_rel); }
+
+void ProfilerDump(std::size_t top) {
+    uint64_t dropped = 0;
+    auto rows = ProfilerCollect(&dropped);
+    LOG(INFO) << "ProcessEvent profile: " << rows.size() << " functions, " << dropped
+              << " calls dropped by full tables";
+    auto dump = [&](const char *title) {
+        LOG(INFO) << "Top " << top << " by " << title << ":";
+        for (std::size_t i = 0; i < std::min(top, rows.size()); ++i) {
+            const auto &row = rows[i];
+            LOG(INFO) << row.Name << " | calls " << row.Calls << " | total " << row.TotalUs / 1000.0 << " ms | mean "
+                      << row.MeanUs << " us | p50 " << row.P50Us << " us | p99 " << row.P99Us << " us";
+        }
+    };
+    dump("total time");
+    std::ranges::sort(rows, std::greater{}, &ProfilerRow::P99Us);
+    dump("p99 latency");
+}
+
+void DrawProfiler() {
+    static int top = 20;
+    static int sortBy = 0; // 0: total, 1: p99
+    static std::vector<ProfilerRow> rows;
+    static uint64_t dropped = 0;
+    static std::chrono::steady_clock::time_point refreshed{};
+
+    bool enabled = GProfilerEnabled.load(std::memory_order_relaxed);
+    if (ImGui::Checkbox("Profile ProcessEvent", &enabled)) {
+        if (enabled)
+            TicksPerMicrosecond(); // start calibrating
+        GProfilerEnabled.store(enabled, std::memory_order_relaxed);
+        LOG(INFO) << "ProcessEvent profiler " << (enabled ? "enabled" : "disabled");
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Reset"))
+        ProfilerReset();
+    ImGui::SameLine();
+    if (ImGui::Button("Dump"))
+        ProfilerDump(static_cast<std::size_t>(top));
+    if (ImGui::IsItemHovered())
+        ImGui::SetTooltip("Write the top N functions by total and p99 time to the log");
+
+    auto sampling = static_cast<int>(GProfilerSampling.load(std::memory_order_relaxed));
+    bool samplingChanged = ImGui::RadioButton("Every call", &sampling, 0);
+    ImGui::SameLine();
+    samplingChanged |= ImGui::RadioButton("Every Nth", &sampling, 1);
+    ImGui::SameLine();
+    samplingChanged |= ImGui::RadioButton("Adaptive", &sampling, 2);
+    if (samplingChanged)
+        GProfilerSampling.store(static_cast<ProfilerSampling>(sampling), std::memory_order_relaxed);
+    if (sampling == static_cast<int>(ProfilerSampling::EveryNth)) {
+        auto period = static_cast<int>(GProfilerSamplePeriod.load(std::memory_order_relaxed));
+        if (ImGui::SliderInt("Sample period", &period, 1, static_cast<int>(kMaxPeriod), "%d",
+                             ImGuiSliderFlags_Logarithmic))
+            GProfilerSamplePeriod.store(static_cast<uint32_t>(period), std::memory_order_relaxed);
+    } else if (sampling == static_cast<int>(ProfilerSampling::Adaptive)) {
+        auto budget = GProfilerBudget.load(std::memory_order_relaxed) * 100.f;
+        if (ImGui::SliderFloat("CPU budget %", &budget, 0.05f, 5.0f, "%.2f", ImGuiSliderFlags_Logarithmic))
+            GProfilerBudget.store(budget / 100.f, std::memory_order_relaxed);
+        if (ImGui::IsItemHovered())
+            ImGui::SetTooltip("Share of each thread's time that sampled calls may spend in instrumentation");
+        {
+            std::lock_guard guard(GTablesMutex);
+            for (std::size_t i = 0; i < GTables.size(); ++i)
+                ImGui::Text("thread %zu: 1 in %u", i, GTables[i]->Period.load(std::memory_order_relaxed));
+        }
+    }
+
+    ImGui::SliderInt("Top N", &top, 5, 100);
+    bool resort = ImGui::RadioButton("By total", &sortBy, 0);
+    ImGui::SameLine();
+    resort |= ImGui::RadioButton("By p99", &sortBy, 1);
+
+    // merging walks every slot of every thread table, so refresh at a human rate rather than per frame
+    const auto now = std::chrono::steady_clock::now();
+    if (now - refreshed > std::chrono::milliseconds(250)) {
+        rows = ProfilerCollect(&dropped);
+        refreshed = now;
+        resort = true;
+    }
+    if (resort && sortBy == 1)
+        std::ranges::sort(rows, std::greater{}, &ProfilerRow::P99Us);
+    else if (resort)
+        std::ranges::sort(rows, std::greater{}, &ProfilerRow::TotalUs);
+
+    if (dropped != 0) {
+        ImGui::TextColored(ImVec4(1.f, 0.8f, 0.2f, 1.f), "%llu calls dropped: a thread's table is full",
+                           static_cast<unsigned long long>(dropped));
+        if (ImGui::IsItemHovered())
+            ImGui::SetTooltip("Those calls are in no row below; Reset to clear the tables");
+    }
+    if (ImGui::BeginTable("##profile", 6, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+        ImGui::TableSetupColumn("Function", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableSetupColumn("Calls");
+        ImGui::TableSetupColumn("Total ms");
+        ImGui::TableSetupColumn("Mean us");
+        ImGui::TableSetupColumn("p50 us");
+        ImGui::TableSetupColumn("p99 us");
+        ImGui::TableHeadersRow();
+        for (std::size_t i = 0; i < std::min(static_cast<std::size_t>(top), rows.size()); ++i) {
+            const auto &row = rows[i];
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(row.Name.c_str());
+            ImGui::TableNextColumn();
+            ImGui::Text("%llu", static_cast<unsigned long long>(row.Calls));
+            ImGui::TableNextColumn();
+            ImGui::Text("%.2f", row.TotalUs / 1000.0);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.2f", row.MeanUs);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.2f", row.P50Us);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.2f", row.P99Us);
+        }
+        ImGui::EndTable();
+    }
+}
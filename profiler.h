@@ -0,0 +1,66 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <intrin.h>
+
+namespace SDK {
+class UFunction;
+}
+
+// opt-in: when off, MyProcessEvent pays a single relaxed load per call
+extern std::atomic_bool GProfilerEnabled;
+
+// which calls get timed; aggregates are scaled back up by the period in effect when a sample was taken
+enum class ProfilerSampling : int { EveryCall = 0, EveryNth = 1, Adaptive = 2 };
+extern std::atomic<ProfilerSampling> GProfilerSampling;
+extern std::atomic<uint32_t> GProfilerSamplePeriod; // EveryNth
+extern std::atomic<float> GProfilerBudget;          // Adaptive: instrumentation time / wall time, per thread
+
+struct ProfilerSampler {
+    uint32_t Countdown = 1; // first call on every thread is sampled
+    uint32_t Weight = 1;    // period the running countdown was armed with; the weight of the sample it ends in
+    uint32_t Period = 1;    // decided by the last ProfilerRecord, armed by the next ProfilerArm
+    uint64_t WindowStart = 0;
+    uint64_t WindowOverhead = 0;
+};
+extern thread_local ProfilerSampler TProfilerSampler;
+
+// the only cost an unsampled call pays
+inline bool ProfilerShouldSample() { return --TProfilerSampler.Countdown == 0; }
+
+// after ProfilerShouldSample() said yes and before the call runs, so ProcessEvents nested in a sampled call count
+// down and get sampled on their own; returns the weight to pass to ProfilerRecord
+inline uint32_t ProfilerArm() {
+    auto &sampler = TProfilerSampler;
+    const auto weight = sampler.Weight;
+    sampler.Weight = sampler.Period;
+    sampler.Countdown = sampler.Period;
+    return weight;
+}
+
+struct ProfilerRow {
+    SDK::UFunction *Function; // identity only; may have been freed since
+    int32_t OuterIndex;       // object index of the owning class, taken with the name
+    std::string Name;
+    uint64_t Calls;
+    double TotalUs;
+    double MeanUs;
+    double P50Us;
+    double P99Us;
+};
+
+inline uint64_t ProfilerNow() { return __rdtsc(); }
+
+// called on the thread that ran GProcessEvent with the weight ProfilerArm() returned; ticks are inclusive of nested
+// ProcessEvent calls. Picks the period the thread's next ProfilerArm() will use.
+extern void ProfilerRecord(SDK::UFunction *function, uint64_t ticks, uint32_t weight);
+// merges all per-thread tables, sorted by total time descending; dropped, if given, receives the calls that found
+// their thread's table full and are in no row
+extern std::vector<ProfilerRow> ProfilerCollect(uint64_t *dropped = nullptr);
+extern void ProfilerReset();
+extern void ProfilerDump(std::size_t top);
+extern void DrawProfiler();
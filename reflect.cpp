@@ -0,0 +1,474 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <utility>
+
+#include <imgui.h>
+
+#include <easylogging++.h>
+
+#include <SDK/Engine_classes.hpp>
+#include <SDK/GbxDynamicWind_classes.hpp>
+#include <SDK/GbxTimeOfDay_classes.hpp>
+
+#include "handle.h"
+#include "reflect.h"
+#include "tasks.h"
+
+namespace {
+
+// =========================
+// Descriptor building and cache
+// =========================
+constexpr int kMaxStructDepth = 4;
+
+bool Has(SDK::FField *field, SDK::EClassCastFlags flag) {
+    return (field->ClassPrivate->CastFlags & static_cast<uint64_t>(flag)) != 0;
+}
+
+// scalar kind of a property, false for anything we don't override (objects, strings, containers, ...)
+bool ScalarKind(SDK::FField *field, PropertyKind &kind) {
+    using enum SDK::EClassCastFlags;
+    if (Has(field, EnumProperty))
+        return ScalarKind(static_cast<SDK::FEnumProperty *>(field)->UnderlayingProperty, kind);
+    if (Has(field, BoolProperty))
+        kind = PropertyKind::Bool;
+    else if (Has(field, FloatProperty))
+        kind = PropertyKind::Float;
+    else if (Has(field, DoubleProperty))
+        kind = PropertyKind::Double;
+    else if (Has(field, Int8Property) || Has(field, Int16Property) || Has(field, IntProperty) ||
+             Has(field, Int64Property))
+        kind = PropertyKind::Int;
+    else if (Has(field, ByteProperty) || Has(field, UInt16Property) || Has(field, UInt32Property) ||
+             Has(field, UInt64Property))
+        kind = PropertyKind::UInt;
+    else
+        return false;
+    return true;
+}
+
+void Collect(SDK::UStruct *type, uint32_t base, const std::string &prefix, int depth,
+             std::vector<PropertyDesc> &out) {
+    if (type->Super)
+        Collect(type->Super, base, prefix, depth, out);
+    for (auto field = type->ChildProperties; field; field = field->Next) {
+        auto property = static_cast<SDK::FProperty *>(field);
+        const auto dim = std::max(property->ArrayDim, 1);
+        for (int i = 0; i < dim; ++i) {
+            auto name = prefix + field->Name.ToString();
+            if (dim > 1)
+                name += "[" + std::to_string(i) + "]";
+            const auto offset = base + static_cast<uint32_t>(property->Offset + i * property->ElementSize);
+
+            if (Has(field, SDK::EClassCastFlags::StructProperty)) {
+                if (depth < kMaxStructDepth)
+                    Collect(static_cast<SDK::FStructProperty *>(field)->Struct, offset, name + ".", depth + 1, out);
+                continue;
+            }
+            PropertyKind kind;
+            if (!ScalarKind(field, kind))
+                continue;
+            if (kind == PropertyKind::Bool) {
+                auto boolean = static_cast<SDK::FBoolProperty *>(field);
+                out.push_back({std::move(name), offset + boolean->ByteOffset, 1, boolean->ByteMask, kind});
+            } else {
+                out.push_back({std::move(name), offset, static_cast<uint16_t>(property->ElementSize), 0, kind});
+            }
+        }
+    }
+}
+
+// Blueprint classes are freed with their map and another struct can be allocated at the same address, so each entry
+// keeps a handle to the struct it describes and is rebuilt once that handle goes stale. Replaced descriptors are
+// retired rather than freed: references already handed out stay valid.
+struct CachedDesc {
+    ObjectHandle Handle;
+    std::unique_ptr<StructDesc> Desc;
+
+    bool Describes(SDK::UStruct *type) const { return Desc && Handle.Get() == type; }
+};
+std::shared_mutex GDescsMutex;
+std::unordered_map<SDK::UStruct *, CachedDesc> GDescs;
+std::vector<std::unique_ptr<StructDesc>> GRetiredDescs;
+
+} // namespace
+
+const PropertyDesc *StructDesc::Find(std::string_view name) const {
+    auto it = ByName.find(std::string(name));
+    return it == ByName.end() ? nullptr : &Properties[it->second];
+}
+
+const StructDesc &DescribeStruct(SDK::UStruct *type) {
+    {
+        std::shared_lock lock(GDescsMutex);
+        if (auto it = GDescs.find(type); it != GDescs.end() && it->second.Describes(type))
+            return *it->second.Desc;
+    }
+    auto desc = std::make_unique<StructDesc>();
+    desc->Struct = type;
+    Collect(type, 0, "", 0, desc->Properties);
+    for (std::size_t i = 0; i < desc->Properties.size(); ++i)
+        desc->ByName.emplace(desc->Properties[i].Name, i);
+
+    std::unique_lock lock(GDescsMutex);
+    auto &cached = GDescs[type];
+    if (cached.Describes(type))
+        return *cached.Desc; // another thread got there first
+    if (cached.Desc) {
+        LOG(INFO) << "Struct at " << static_cast<const void *>(type) << " was replaced; describing it again";
+        GRetiredDescs.push_back(std::move(cached.Desc));
+    }
+    cached = {ObjectHandle::Of(type), std::move(desc)};
+    LOG(INFO) << "Described " << type->GetName() << ": " << cached.Desc->Properties.size() << " scalar properties";
+    return *cached.Desc;
+}
+
+std::vector<OverridePair> PairOverrides(const StructDesc &desc) {
+    constexpr std::string_view prefix = "bOverride_";
+    std::vector<OverridePair> pairs;
+    for (const auto &property : desc.Properties) {
+        if (property.Kind != PropertyKind::Bool)
+            continue;
+        const auto dot = property.Name.rfind('.');
+        const auto leaf = dot == std::string::npos ? 0 : dot + 1;
+        if (!std::string_view(property.Name).substr(leaf).starts_with(prefix))
+            continue;
+        if (auto value = desc.Find(property.Name.substr(0, leaf) + property.Name.substr(leaf + prefix.size())))
+            pairs.push_back({value, &property});
+    }
+    return pairs;
+}
+
+PropertyOverride EncodeOverride(const PropertyDesc &property, double value) {
+    PropertyOverride encoded{property.Offset, property.Size, property.Mask, 0};
+    switch (property.Kind) {
+    case PropertyKind::Bool:
+        encoded.Bits = value != 0.0 ? property.Mask : 0;
+        break;
+    case PropertyKind::Int:
+        encoded.Bits = static_cast<uint64_t>(std::llround(value)); // two's complement; only Size bytes are written
+        break;
+    case PropertyKind::UInt:
+        encoded.Bits = value <= 0.0 ? 0 : static_cast<uint64_t>(std::llround(value));
+        break;
+    case PropertyKind::Float:
+        encoded.Bits = std::bit_cast<uint32_t>(static_cast<float>(value));
+        break;
+    case PropertyKind::Double:
+        encoded.Bits = std::bit_cast<uint64_t>(value);
+        break;
+    }
+    return encoded;
+}
+
+double ReadProperty(const void *base, const PropertyDesc &property) {
+    uint64_t raw = 0;
+    std::memcpy(&raw, static_cast<const uint8_t *>(base) + property.Offset, property.Size);
+    switch (property.Kind) {
+    case PropertyKind::Bool:
+        return (raw & property.Mask) != 0 ? 1.0 : 0.0;
+    case PropertyKind::Int: {
+        const auto shift = 64 - 8 * property.Size;
+        return static_cast<double>(static_cast<int64_t>(raw << shift) >> shift);
+    }
+    case PropertyKind::UInt:
+        return static_cast<double>(raw);
+    case PropertyKind::Float:
+        return std::bit_cast<float>(static_cast<uint32_t>(raw));
+    case PropertyKind::Double:
+        return std::bit_cast<double>(raw);
+    }
+    return 0.0;
+}
+
+void ApplyOverrides(void *base, std::span<const PropertyOverride> overrides) {
+    auto bytes = static_cast<uint8_t *>(base);
+    for (const auto &o : overrides) {
+        if (o.Mask)
+            bytes[o.Offset] = static_cast<uint8_t>((bytes[o.Offset] & ~o.Mask) | (o.Bits & o.Mask));
+        else
+            std::memcpy(bytes + o.Offset, &o.Bits, o.Size);
+    }
+}
+
+namespace {
+
+// =========================
+// Targets and the plans handed to the game thread
+// =========================
+struct ReflectionPlan {
+    SDK::UObject *Object;
+    ObjectHandle Handle; // taken when the object was resolved; invalid once it is gone
+    std::vector<PropertyOverride> Overrides;
+
+    bool Alive() const { return Handle.Get() == Object; }
+};
+
+std::atomic_bool GStickyAny = false;
+std::atomic<std::shared_ptr<const std::vector<ReflectionPlan>>> GStickyPlans;
+
+struct Edit {
+    bool Enabled = false;
+    double Value = 0.0;
+};
+
+// what the game thread found when resolving a target; the overlay never dereferences Object itself
+struct Resolved {
+    SDK::UObject *Object = nullptr;
+    ObjectHandle Handle;
+    const StructDesc *Desc = nullptr;
+};
+
+// the object's name and current property values, read on the game thread; empty once the object is gone
+struct Readout {
+    std::string Name;
+    std::vector<double> Values; // aligned with Desc->Properties
+};
+constexpr auto kReadoutInterval = std::chrono::milliseconds(100);
+
+struct Target {
+    const char *Label;
+    SDK::UObject *(*Resolve)(); // game thread
+    std::future<Resolved> Pending;
+    SDK::UObject *Object = nullptr;
+    ObjectHandle Handle;
+    const StructDesc *Desc = nullptr;
+    std::future<std::optional<Readout>> Reading;
+    std::chrono::steady_clock::time_point LastRead;
+    Readout Shown;
+    std::unordered_map<std::string, Edit> Edits;
+    bool Sticky = false;
+    char Filter[64]{};
+};
+
+std::array<Target, 3> GTargets = {
+    Target{"GameUserSettings",
+           []() -> SDK::UObject * {
+               auto engine = SDK::UEngine::GetEngine();
+               return engine ? engine->GameUserSettings : nullptr;
+           }},
+    Target{"WorldTimeOfDayActor",
+           []() -> SDK::UObject * {
+               auto world = SDK::UWorld::GetWorld();
+               return world ? SDK::UGameplayStatics::GetActorOfClass(world, SDK::AWorldTimeOfDayActor::StaticClass())
+                            : nullptr;
+           }},
+    Target{"GbxWindProjectSettings",
+           []() -> SDK::UObject * { return SDK::UGbxWindProjectSettings::GetDefaultObj(); }},
+};
+
+ReflectionPlan Compile(const Target &target) {
+    ReflectionPlan plan{target.Object, target.Handle, {}};
+    for (const auto &[name, edit] : target.Edits)
+        if (edit.Enabled)
+            if (auto property = target.Desc->Find(name))
+                plan.Overrides.push_back(EncodeOverride(*property, edit.Value));
+    // ascending offsets keep the apply loop walking memory forwards
+    std::ranges::sort(plan.Overrides, {}, &PropertyOverride::Offset);
+    return plan;
+}
+
+void PublishSticky() {
+    auto plans = std::make_shared<std::vector<ReflectionPlan>>();
+    for (const auto &target : GTargets)
+        if (target.Sticky && target.Object && target.Desc)
+            if (auto plan = Compile(target); !plan.Overrides.empty())
+                plans->push_back(std::move(plan));
+    GStickyAny.store(!plans->empty(), std::memory_order_relaxed);
+    GStickyPlans.store(std::move(plans), std::memory_order_release);
+}
+
+bool Matches(const std::string &name, const char *filter) {
+    if (!*filter)
+        return true;
+    auto it = std::ranges::search(name, std::string_view(filter), [](char a, char b) {
+                  return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+              }).begin();
+    return it != name.end();
+}
+
+const char *KindName(PropertyKind kind) {
+    switch (kind) {
+    case PropertyKind::Bool:
+        return "bool";
+    case PropertyKind::Int:
+        return "int";
+    case PropertyKind::UInt:
+        return "uint";
+    case PropertyKind::Float:
+        return "float";
+    case PropertyKind::Double:
+        return "double";
+    }
+    return "?";
+}
+
+// game thread
+Resolved ResolveTarget(SDK::UObject *(*resolve)()) {
+    auto object = resolve();
+    return {object, ObjectHandle::Of(object), object ? &DescribeStruct(object->Class) : nullptr};
+}
+
+// game thread
+std::optional<Readout> ReadTarget(SDK::UObject *object, ObjectHandle handle, const StructDesc *desc) {
+    if (handle.Get() != object)
+        return std::nullopt;
+    Readout out{object->GetName(), {}};
+    out.Values.reserve(desc->Properties.size());
+    for (const auto &property : desc->Properties)
+        out.Values.push_back(ReadProperty(object, property));
+    return out;
+}
+
+bool Ready(auto &future) { return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready; }
+
+// Objects can be destroyed with the map they belong to, so everything shown comes from readouts taken on the game
+// thread; a readout that finds the handle stale drops the target back to unresolved.
+void DrawTarget(Target &target) {
+    if (target.Pending.valid()) {
+        if (!Ready(target.Pending)) {
+            ImGui::TextDisabled("resolving on the game thread...");
+            return;
+        }
+        const auto resolved = target.Pending.get();
+        target.Object = resolved.Object;
+        target.Handle = resolved.Handle;
+        target.Desc = resolved.Desc;
+        target.Reading = {};
+        target.Shown = {};
+        target.LastRead = {};
+        PublishSticky();
+    }
+    if (ImGui::Button("Resolve"))
+        target.Pending = RunOnGameThread([resolve = target.Resolve] { return ResolveTarget(resolve); });
+    if (target.Reading.valid() && Ready(target.Reading)) {
+        if (auto readout = target.Reading.get()) {
+            target.Shown = std::move(*readout);
+        } else {
+            target.Object = nullptr;
+            target.Desc = nullptr;
+            target.Shown = {};
+            PublishSticky();
+        }
+    }
+    if (!target.Object || !target.Desc) {
+        ImGui::SameLine();
+        ImGui::TextDisabled("not resolved");
+        return;
+    }
+    const auto now = std::chrono::steady_clock::now();
+    if (!target.Reading.valid() && now - target.LastRead >= kReadoutInterval) {
+        target.Reading = RunOnGameThread([object = target.Object, handle = target.Handle, desc = target.Desc] {
+            return ReadTarget(object, handle, desc);
+        });
+        target.LastRead = now;
+    }
+    ImGui::SameLine();
+    if (target.Shown.Name.empty())
+        ImGui::TextDisabled("reading on the game thread...");
+    else
+        ImGui::Text("%s, %zu properties", target.Shown.Name.c_str(), target.Desc->Properties.size());
+
+    bool changed = false;
+    if (ImGui::Checkbox("Keep applied", &target.Sticky))
+        changed = true;
+    if (ImGui::IsItemHovered())
+        ImGui::SetTooltip("Re-apply every camera update, for properties the game keeps rewriting");
+    ImGui::SameLine();
+    if (ImGui::Button("Apply once")) {
+        EnqueueGameTask([plan = Compile(target)] {
+            if (plan.Alive())
+                ApplyOverrides(plan.Object, plan.Overrides);
+        });
+    }
+    ImGui::InputText("Filter", target.Filter, sizeof(target.Filter));
+
+    std::vector<std::size_t> rows;
+    for (std::size_t i = 0; i < target.Desc->Properties.size(); ++i)
+        if (Matches(target.Desc->Properties[i].Name, target.Filter))
+            rows.push_back(i);
+
+    constexpr auto flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY;
+    if (ImGui::BeginTable("##properties", 4, flags, ImVec2(0, 320))) {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("Property");
+        ImGui::TableSetupColumn("Type");
+        ImGui::TableSetupColumn("Current");
+        ImGui::TableSetupColumn("Override");
+        ImGui::TableHeadersRow();
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(rows.size()));
+        while (clipper.Step()) {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+                const auto index = rows[row];
+                const auto &property = target.Desc->Properties[index];
+                auto &edit = target.Edits[property.Name];
+                ImGui::PushID(property.Name.c_str());
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(property.Name.c_str());
+                ImGui::TableNextColumn();
+                ImGui::Text("%s%u @%04X", KindName(property.Kind), property.Size * 8u, property.Offset);
+                ImGui::TableNextColumn();
+                if (index < target.Shown.Values.size())
+                    ImGui::Text("%g", target.Shown.Values[index]);
+                else
+                    ImGui::TextDisabled("-");
+                ImGui::TableNextColumn();
+                if (ImGui::Checkbox("##enabled", &edit.Enabled))
+                    changed = true;
+                if (edit.Enabled) {
+                    ImGui::SameLine();
+                    if (property.Kind == PropertyKind::Bool) {
+                        bool value = edit.Value != 0.0;
+                        if (ImGui::Checkbox("##value", &value)) {
+                            edit.Value = value ? 1.0 : 0.0;
+                            changed = true;
+                        }
+                    } else if (ImGui::InputDouble("##value", &edit.Value)) {
+                        changed = true;
+                    }
+                }
+                ImGui::PopID();
+            }
+        }
+        ImGui::EndTable();
+    }
+    if (changed)
+        PublishSticky();
+}
+
+} // namespace
+
+void TickReflection() {
+    if (!GStickyAny.load(std::memory_order_relaxed)) [[likely]]
+        return;
+    auto plans = GStickyPlans.load(std::memory_order_acquire);
+    for (const auto &plan : *plans)
+        if (plan.Alive())
+            ApplyOverrides(plan.Object, plan.Overrides);
+}
+
+void DrawReflection() {
+    static int current = 0;
+    for (int i = 0; i < static_cast<int>(GTargets.size()); ++i) {
+        if (i)
+            ImGui::SameLine();
+        ImGui::RadioButton(GTargets[i].Label, &current, i);
+    }
+    ImGui::PushID(current);
+    DrawTarget(GTargets[current]);
+    ImGui::PopID();
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace SDK {
+class UObject;
+class UStruct;
+} // namespace SDK
+
+// Runtime counterpart of the PPS_FIELDS setters: scalar properties of any UStruct, found by walking ChildProperties
+// (and Super, and nested struct properties), so objects without a hand-written schema can be overridden too.
+
+enum class PropertyKind : uint8_t { Bool, Int, UInt, Float, Double };
+
+struct PropertyDesc {
+    std::string Name; // nested struct members are dotted, static array elements get [i]
+    uint32_t Offset;  // from the start of the outermost struct
+    uint16_t Size;
+    uint8_t Mask; // bool bit within the byte at Offset; 0 for everything else
+    PropertyKind Kind;
+};
+
+struct StructDesc {
+    SDK::UStruct *Struct;
+    std::vector<PropertyDesc> Properties;
+    std::unordered_map<std::string, std::size_t> ByName;
+
+    const PropertyDesc *Find(std::string_view name) const;
+};
+
+// a value property and its bOverride_ flag, paired by name (bOverride_Foo and Foo, in the same nested struct)
+struct OverridePair {
+    const PropertyDesc *Value;
+    const PropertyDesc *Override;
+};
+
+// a pre-encoded write: Size bytes of Bits at Offset, or the Mask bits of one byte
+struct PropertyOverride {
+    uint32_t Offset;
+    uint16_t Size;
+    uint8_t Mask;
+    uint64_t Bits;
+};
+
+// built on first use and cached, and rebuilt if the struct was freed and another took its address; the reference stays
+// valid for the lifetime of the process. Safe from any thread.
+extern const StructDesc &DescribeStruct(SDK::UStruct *type);
+// in the order the flags are declared; both pointers live as long as the StructDesc
+extern std::vector<OverridePair> PairOverrides(const StructDesc &desc);
+extern PropertyOverride EncodeOverride(const PropertyDesc &property, double value);
+extern double ReadProperty(const void *base, const PropertyDesc &property);
+extern void ApplyOverrides(void *base, std::span<const PropertyOverride> overrides);
+
+// game thread: re-applies the overrides marked "Keep applied" in the overlay
+extern void TickReflection();
+extern void DrawReflection();
@@ -0,0 +1,151 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <easylogging++.h>
+
+#include "schema.h"
+#include "search.h"
+
+// =========================
+// Index: every n-gram (n = 1..3) of the lowercased "key\ninfo" text, with the sorted items it occurs in
+// =========================
+static constexpr std::size_t kMaxGram = 3;
+
+struct gram_index {
+    std::vector<std::string> texts; // lowercased key and tooltip per item, for checking candidates
+    std::vector<uint32_t> grams;    // packed n-grams, ascending
+    std::vector<uint32_t> offsets;  // postings of grams[g] are [offsets[g], offsets[g + 1])
+    std::vector<uint16_t> postings;
+    float build_ms = 0.f;
+};
+
+static char lower(char c) { return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c; }
+
+// up to three bytes, with the length in the top byte so "a" and "a\0\0" stay apart
+static uint32_t pack(std::string_view gram) {
+    uint32_t packed = static_cast<uint32_t>(gram.size()) << 24;
+    for (std::size_t i = 0; i < gram.size(); ++i)
+        packed |= static_cast<uint32_t>(static_cast<unsigned char>(gram[i])) << (8 * i);
+    return packed;
+}
+
+static gram_index build() {
+    const auto start = std::chrono::steady_clock::now();
+    gram_index index;
+    std::vector<std::pair<uint32_t, uint16_t>> pairs;
+    for (std::size_t i = 0; i < kItemCount; ++i) {
+        auto text = std::string(kItems[i].key) + '\n' + kItems[i].info;
+        std::ranges::transform(text, text.begin(), lower);
+        for (std::size_t at = 0; at < text.size(); ++at)
+            for (std::size_t n = 1; n <= kMaxGram && at + n <= text.size(); ++n)
+                pairs.emplace_back(pack(std::string_view(text).substr(at, n)), static_cast<uint16_t>(i));
+        index.texts.push_back(std::move(text));
+    }
+    std::ranges::sort(pairs);
+    pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+    index.postings.reserve(pairs.size());
+    for (const auto &[gram, item] : pairs) {
+        if (index.grams.empty() || index.grams.back() != gram) {
+            index.grams.push_back(gram);
+            index.offsets.push_back(static_cast<uint32_t>(index.postings.size()));
+        }
+        index.postings.push_back(item);
+    }
+    index.offsets.push_back(static_cast<uint32_t>(index.postings.size()));
+    index.build_ms = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    LOG(INFO) << "Search index: " << index.grams.size() << " n-grams, " << index.postings.size() << " postings, "
+              << index.build_ms << " ms";
+    return index;
+}
+
+static const gram_index &search_index() {
+    static const gram_index built = build();
+    return built;
+}
+
+static std::span<const uint16_t> postings_of(const gram_index &index, std::string_view gram) {
+    const auto it = std::ranges::lower_bound(index.grams, pack(gram));
+    if (it == index.grams.end() || *it != pack(gram))
+        return {};
+    const auto g = static_cast<std::size_t>(it - index.grams.begin());
+    return std::span(index.postings).subspan(index.offsets[g], index.offsets[g + 1] - index.offsets[g]);
+}
+
+// =========================
+// Queries
+// =========================
+static bool gAnswered = false;
+static std::string gQuery; // lowercased, as last answered
+static std::vector<uint16_t> gMatches;
+static std::vector<uint16_t> gScratch;
+static float gQueryUs = 0.f;
+
+static void lookup(const gram_index &index, std::string_view query) {
+    if (query.size() <= kMaxGram) {
+        const auto list = postings_of(index, query);
+        gMatches.assign(list.begin(), list.end());
+        return;
+    }
+    // start from the rarest trigram, then narrow by the others
+    std::span<const uint16_t> rarest;
+    std::size_t rarest_at = 0;
+    for (std::size_t at = 0; at + kMaxGram <= query.size(); ++at) {
+        const auto list = postings_of(index, query.substr(at, kMaxGram));
+        if (list.empty()) {
+            gMatches.clear();
+            return;
+        }
+        if (at == 0 || list.size() < rarest.size()) {
+            rarest = list;
+            rarest_at = at;
+        }
+    }
+    gMatches.assign(rarest.begin(), rarest.end());
+    for (std::size_t at = 0; at + kMaxGram <= query.size() && !gMatches.empty(); ++at) {
+        if (at == rarest_at)
+            continue;
+        const auto list = postings_of(index, query.substr(at, kMaxGram));
+        gScratch.clear();
+        std::ranges::set_intersection(gMatches, list, std::back_inserter(gScratch));
+        gMatches.swap(gScratch);
+    }
+    // trigrams can all occur without occurring in a row
+    std::erase_if(gMatches, [&](uint16_t item) { return index.texts[item].find(query) == std::string::npos; });
+}
+
+const std::vector<uint16_t> &search_items(std::string_view query) {
+    const auto &idx = search_index();
+    std::string lowered(query);
+    std::ranges::transform(lowered, lowered.begin(), lower);
+    if (gAnswered && lowered == gQuery)
+        return gMatches;
+
+    const auto start = std::chrono::steady_clock::now();
+    if (lowered.empty()) {
+        gMatches.resize(kItemCount);
+        for (std::size_t i = 0; i < kItemCount; ++i)
+            gMatches[i] = static_cast<uint16_t>(i);
+    } else if (gAnswered && lowered.find(gQuery) != std::string::npos) {
+        // the query grew around the previous one: whatever matches now matched before
+        std::erase_if(gMatches, [&](uint16_t item) { return idx.texts[item].find(lowered) == std::string::npos; });
+    } else {
+        lookup(idx, lowered);
+    }
+    gQuery = std::move(lowered);
+    gAnswered = true;
+    gQueryUs = std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - start).count();
+    return gMatches;
+}
+
+search_stats search_index_stats() {
+    const auto &idx = search_index();
+    return {idx.grams.size(), idx.postings.size(), idx.build_ms, gQueryUs};
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// Override browser search: a case-insensitive substring match over every schema item's key and tooltip, answered from
+// an n-gram index (all 1-, 2- and 3-grams, one sorted posting list each) built on first use. Queries of up to three
+// characters are a single posting list; longer ones intersect their trigrams' lists and check the few survivors. A
+// query that extends the previous one only re-checks the previous matches, so typing costs O(matches) per keystroke.
+
+// schema indices matching query, ascending; valid until the next call (render thread)
+const std::vector<uint16_t> &search_items(std::string_view query);
+
+struct search_stats {
+    std::size_t grams = 0;
+    std::size_t postings = 0;
+    float build_ms = 0.f;
+    float query_us = 0.f; // last search_items() call
+};
+search_stats search_index_stats();
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <SDK/Engine_structs.hpp>
+
+// Single-writer/single-reader triple buffer. The writer fills back() and publishes it; the reader always gets the
+// newest published buffer. Neither side blocks, and the reader never sees a half-written buffer.
+template <typename T> class triple_buffer {
+  public:
+    // writer: the buffer to fill; it holds stale contents from an older publish, so write every field
+    T &back() { return buffers_[back_]; }
+    void publish() { back_ = middle_.exchange(back_ | kFresh, std::memory_order_acq_rel) & kIndex; }
+
+    // reader: stays valid until the next read()
+    const T &read() {
+        if (middle_.load(std::memory_order_relaxed) & kFresh)
+            front_ = middle_.exchange(front_, std::memory_order_acq_rel) & kIndex;
+        return buffers_[front_];
+    }
+    // reader: what the last read() returned, without picking up anything newer
+    const T &current() const { return buffers_[front_]; }
+
+  private:
+    static constexpr uint8_t kIndex = 0x3;
+    static constexpr uint8_t kFresh = 0x4;
+
+    std::array<T, 3> buffers_{};
+    std::atomic<uint8_t> middle_ = 1;
+    uint8_t back_ = 0;
+    uint8_t front_ = 2;
+};
+
+struct zone_map; // zones.cpp
+
+// Gbx sub-structs of FPostProcessSettings (fields.h), delivered sparsely: a block is only touched while one of its
+// items is overridden, and then only those items are written
+inline constexpr std::size_t kGbxBlocks = 5;
+
+// one time-of-day curve: keys [first, first + count) of the flat arrays below, hours ascending
+struct curve_span {
+    uint16_t item; // schema index
+    uint16_t first;
+    uint16_t count;
+};
+
+// BlueprintModifyCamera channel (see view.h)
+struct view_override {
+    bool enabled = false;
+    float fov = 0.f;                 // degrees; 0 keeps the game's
+    std::array<float, 3> offset{};   // forward, right, up in view space
+    std::array<float, 3> rotation{}; // pitch, yaw, roll added to the view
+};
+
+// everything the camera update needs, published as a unit by the render thread (see publish_overrides)
+struct override_snapshot {
+    uint64_t serial = 0; // bumped on every publish
+    float weight = 0.f;  // 0 when the global gate is off
+    SDK::FPostProcessSettings settings{};
+    uint8_t gbx_active = 0;                         // bit per Gbx block with at least one overridden item
+    std::array<uint64_t, kGbxBlocks> gbx_serials{}; // a block's serial moves whenever one of its items changes
+
+    std::vector<curve_span> curves;
+    std::vector<float> curve_hours;
+    std::vector<float> curve_values;
+    float preview_hour = -1.f; // >= 0 pins curve evaluation to this hour instead of the game's clock
+
+    std::shared_ptr<const zone_map> zones; // keeps a mapped zone file alive while the game thread may use it
+
+    view_override view;
+};
@@ -0,0 +1,299 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <imgui.h>
+
+#include <SDK/Engine_classes.hpp>
+
+#include "frames.h"
+#include "streaming.h"
+
+std::atomic<uint64_t> GStreamingScans = 0;
+
+namespace {
+
+enum class TransitionKind : uint8_t { Visible, Invisible, Registered, Unregistered };
+constexpr const char *kKindNames[] = {"made visible", "made invisible", "registered", "unregistered"};
+
+struct Transition {
+    std::string Level;
+    TransitionKind Kind;
+    int64_t StartNs; // steady_clock, same base as frame_sample::end_ns
+    int64_t EndNs;   // == StartNs for registrations, which are instantaneous
+};
+
+// =========================
+// Transition ring (producer: game thread, consumer: overlay); transitions are rare, so a mutex is plenty
+// =========================
+constexpr std::size_t kRingSize = 1024;
+std::mutex GRingMutex;
+std::array<Transition, kRingSize> GRing;
+uint64_t GRingHead = 0;
+
+std::atomic<float> GSampleNs = 0.f; // moving average of SampleStreaming, for the panel
+std::atomic<uint32_t> GInFlightCount = 0;
+
+int64_t NowNs() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+void Push(Transition transition) {
+    std::lock_guard guard(GRingMutex);
+    GRing[GRingHead++ % kRingSize] = std::move(transition);
+}
+
+// =========================
+// Sampler state (game thread)
+// =========================
+// what is compared every update; a change in any of these triggers the diff
+struct ArrayView {
+    const void *Data = nullptr;
+    int32_t Num = 0;
+    const void *First = nullptr; // catches a same-size swap in place, the common case for one-element arrays
+
+    template <typename T> static ArrayView Of(const SDK::TArray<T *> &array) {
+        return {array.GetDataPtr(), array.Num(), array.Num() > 0 ? array.GetDataPtr()[0] : nullptr};
+    }
+    bool operator==(const ArrayView &) const = default;
+};
+
+struct InFlight {
+    SDK::ULevel *Level;
+    TransitionKind Kind;
+    int64_t StartNs;
+    std::string Name;
+};
+
+SDK::UWorld *GWorld = nullptr;
+ArrayView GVisibleView, GInvisibleView, GStreamingView;
+std::vector<InFlight> GInFlight;
+std::vector<SDK::ULevelStreaming *> GRegistered; // sorted
+bool GRegisteredSeeded = false;
+
+std::string LevelName(SDK::ULevel *level) { return (level->Outer ? level->Outer->Name : level->Name).ToString(); }
+
+void Diff(const SDK::TArray<SDK::ULevel *> &levels, TransitionKind kind, int64_t now) {
+    const auto contains = [&](SDK::ULevel *level) {
+        for (int32_t i = 0; i < levels.Num(); ++i)
+            if (levels.GetDataPtr()[i] == level)
+                return true;
+        return false;
+    };
+    std::erase_if(GInFlight, [&](InFlight &flight) {
+        if (flight.Kind != kind || contains(flight.Level))
+            return false;
+        Push({std::move(flight.Name), kind, flight.StartNs, now});
+        return true;
+    });
+    for (int32_t i = 0; i < levels.Num(); ++i) {
+        auto level = levels.GetDataPtr()[i];
+        const auto tracked = [&](const InFlight &flight) { return flight.Kind == kind && flight.Level == level; };
+        if (level && std::ranges::none_of(GInFlight, tracked))
+            GInFlight.push_back({level, kind, now, LevelName(level)});
+    }
+}
+
+// record is false for the first look at a world, which would otherwise report every level it ever registered
+void DiffRegistered(const SDK::TArray<SDK::ULevelStreaming *> &streaming, int64_t now, bool record) {
+    std::vector<SDK::ULevelStreaming *> current(streaming.GetDataPtr(), streaming.GetDataPtr() + streaming.Num());
+    std::erase(current, nullptr);
+    std::ranges::sort(current);
+    if (!record) {
+        GRegistered = std::move(current);
+        return;
+    }
+    std::vector<SDK::ULevelStreaming *> changed;
+    std::ranges::set_difference(current, GRegistered, std::back_inserter(changed));
+    for (auto level : changed)
+        Push({level->PackageNameToLoad.ToString(), TransitionKind::Registered, now, now});
+    changed.clear();
+    // the removed ones may already be garbage; record them without touching them
+    std::ranges::set_difference(GRegistered, current, std::back_inserter(changed));
+    if (!changed.empty())
+        Push({std::to_string(changed.size()) + " streaming level(s)", TransitionKind::Unregistered, now, now});
+    GRegistered = std::move(current);
+}
+
+// =========================
+// Correlation (overlay)
+// =========================
+struct LevelReport {
+    std::string Level;
+    TransitionKind Kind;
+    uint32_t Transitions = 0;
+    uint32_t WithHitch = 0; // transitions that overlapped at least one hitch frame
+    uint32_t Frames = 0;    // frames overlapping the transitions
+    uint32_t Hitches = 0;
+    float WorstMs = 0.f;
+    double DurationMs = 0.0; // summed
+    double Lift = 0.0;       // hitch share of those frames over the hitch share of the whole window
+};
+
+} // namespace
+
+void SampleStreaming() {
+    const auto start = std::chrono::steady_clock::now();
+    auto world = SDK::UWorld::GetWorld();
+    if (world != GWorld) {
+        // a new world: whatever was in flight belonged to the old one
+        GWorld = world;
+        GInFlight.clear();
+        GRegistered.clear();
+        GRegisteredSeeded = false;
+        GVisibleView = GInvisibleView = GStreamingView = {};
+    }
+    if (!world)
+        return;
+    const auto visible = ArrayView::Of(world->MakingVisibleLevels);
+    const auto invisible = ArrayView::Of(world->MakingInvisibleLevels);
+    const auto streaming = ArrayView::Of(world->StreamingLevels);
+    if (visible == GVisibleView && invisible == GInvisibleView && streaming == GStreamingView) [[likely]] {
+        const auto ns = std::chrono::duration<float, std::nano>(std::chrono::steady_clock::now() - start).count();
+        GSampleNs.store(GSampleNs.load(std::memory_order_relaxed) * 0.99f + ns * 0.01f, std::memory_order_relaxed);
+        return;
+    }
+
+    GStreamingScans.fetch_add(1, std::memory_order_relaxed);
+    const auto now = NowNs();
+    if (visible != GVisibleView)
+        Diff(world->MakingVisibleLevels, TransitionKind::Visible, now);
+    if (invisible != GInvisibleView)
+        Diff(world->MakingInvisibleLevels, TransitionKind::Invisible, now);
+    if (streaming != GStreamingView)
+        DiffRegistered(world->StreamingLevels, now, std::exchange(GRegisteredSeeded, true));
+    GVisibleView = visible;
+    GInvisibleView = invisible;
+    GStreamingView = streaming;
+    GInFlightCount.store(static_cast<uint32_t>(GInFlight.size()), std::memory_order_relaxed);
+}
+
+// =========================
+// Overlay panel
+// =========================
+void DrawStreaming() {
+    static float thresholdMs = 50.f;
+    static float lagMs = 50.f;
+    static bool registrations = false;
+    static std::vector<Transition> transitions;
+    static std::vector<frame_sample> frames;
+    static std::vector<LevelReport> reports;
+    static std::chrono::steady_clock::time_point refreshed{};
+
+    ImGui::SliderFloat("Hitch threshold", &thresholdMs, 16.f, 500.f, "%.0f ms", ImGuiSliderFlags_Logarithmic);
+    ImGui::SliderFloat("Render lag", &lagMs, 0.f, 200.f, "%.0f ms");
+    if (ImGui::IsItemHovered())
+        ImGui::SetTooltip("How long after a transition ends its cost can still show up in a presented frame");
+    ImGui::Checkbox("Include registrations", &registrations);
+    if (ImGui::IsItemHovered())
+        ImGui::SetTooltip("Streaming levels added to UWorld::StreamingLevels, as instants rather than spans");
+    ImGui::TextDisabled("Sampling %.0f ns per update, %llu diffs, %u levels in flight",
+                        GSampleNs.load(std::memory_order_relaxed),
+                        static_cast<unsigned long long>(GStreamingScans.load(std::memory_order_relaxed)),
+                        GInFlightCount.load(std::memory_order_relaxed));
+
+    // the join is a binary search per transition over the whole frame ring; a human refresh rate is plenty
+    const auto now = std::chrono::steady_clock::now();
+    if (now - refreshed > std::chrono::milliseconds(500)) {
+        refreshed = now;
+        {
+            std::lock_guard guard(GRingMutex);
+            transitions.clear();
+            for (auto i = GRingHead > kRingSize ? GRingHead - kRingSize : 0; i < GRingHead; ++i)
+                transitions.push_back(GRing[i % kRingSize]);
+        }
+        copy_frames(0, frames);
+
+        uint32_t hitchFrames = 0;
+        for (const auto &frame : frames)
+            hitchFrames += frame.ms > thresholdMs;
+        const auto baseline = frames.empty() ? 0.0 : static_cast<double>(hitchFrames) / frames.size();
+
+        std::map<std::pair<std::string, TransitionKind>, LevelReport> byLevel;
+        const auto lag = static_cast<int64_t>(lagMs * 1e6f);
+        for (const auto &transition : transitions) {
+            if (!registrations &&
+                (transition.Kind == TransitionKind::Registered || transition.Kind == TransitionKind::Unregistered))
+                continue;
+            if (frames.empty() || transition.EndNs + lag < frames.front().end_ns)
+                continue; // older than the frame ring
+            // frames are ordered by end; a frame [end - ms, end] overlaps [start, end + lag]
+            const auto first = std::ranges::lower_bound(frames, transition.StartNs, {}, &frame_sample::end_ns);
+            auto &report = byLevel[{transition.Level, transition.Kind}];
+            report.Level = transition.Level;
+            report.Kind = transition.Kind;
+            ++report.Transitions;
+            report.DurationMs += (transition.EndNs - transition.StartNs) / 1e6;
+            bool hitch = false;
+            for (auto it = first; it != frames.end(); ++it) {
+                if (it->end_ns - static_cast<int64_t>(it->ms * 1e6f) > transition.EndNs + lag)
+                    break;
+                ++report.Frames;
+                if (it->ms > thresholdMs) {
+                    ++report.Hitches;
+                    hitch = true;
+                    report.WorstMs = std::max(report.WorstMs, it->ms);
+                }
+            }
+            report.WithHitch += hitch;
+        }
+        reports.clear();
+        for (auto &[key, report] : byLevel) {
+            if (report.Frames > 0 && baseline > 0.0)
+                report.Lift = static_cast<double>(report.Hitches) / report.Frames / baseline;
+            reports.push_back(std::move(report));
+        }
+        std::ranges::sort(reports, [](const LevelReport &a, const LevelReport &b) {
+            return a.Hitches != b.Hitches ? a.Hitches > b.Hitches : a.Lift > b.Lift;
+        });
+    }
+
+    ImGui::Text("%zu transitions, %zu frames in the window", transitions.size(), frames.size());
+    constexpr auto flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY;
+    if (ImGui::BeginTable("##streaming", 7, flags, ImVec2(0, 280))) {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("Level");
+        ImGui::TableSetupColumn("Transition");
+        ImGui::TableSetupColumn("Count");
+        ImGui::TableSetupColumn("With hitch");
+        ImGui::TableSetupColumn("Mean ms");
+        ImGui::TableSetupColumn("Worst frame ms");
+        ImGui::TableSetupColumn("Lift");
+        ImGui::TableHeadersRow();
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(reports.size()));
+        while (clipper.Step()) {
+            for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i) {
+                const auto &report = reports[i];
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(report.Level.c_str());
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(kKindNames[static_cast<int>(report.Kind)]);
+                ImGui::TableNextColumn();
+                ImGui::Text("%u", report.Transitions);
+                ImGui::TableNextColumn();
+                ImGui::Text("%u", report.WithHitch);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.1f", report.DurationMs / report.Transitions);
+                ImGui::TableNextColumn();
+                if (report.Hitches > 0)
+                    ImGui::Text("%.1f", report.WorstMs);
+                ImGui::TableNextColumn();
+                if (report.Lift > 0.0)
+                    ImGui::Text("%.1fx", report.Lift);
+            }
+        }
+        ImGui::EndTable();
+    }
+    if (ImGui::IsItemHovered())
+        ImGui::SetTooltip("Lift: share of hitch frames while the level was in transition, over the share across the "
+                          "whole window");
+}
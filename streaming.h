@@ -0,0 +1,16 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// Level-streaming hitch correlator. Once per camera update the game thread compares UWorld::MakingVisibleLevels,
+// MakingInvisibleLevels and StreamingLevels against the previous update by data pointer, count and first element;
+// only a change costs a diff. Each level's time in MakingVisible/MakingInvisible becomes a (name, start, end)
+// transition in a ring, and the overlay joins those against the frame ring (frames.h) to rank the levels whose
+// transitions coincide with hitches.
+
+extern std::atomic<uint64_t> GStreamingScans; // updates where something changed and the arrays were diffed
+
+// game thread, once per camera update
+extern void SampleStreaming();
+extern void DrawStreaming();
@@ -0,0 +1,463 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <imgui.h>
+
+#include <easylogging++.h>
+
+#include <SDK/Engine_classes.hpp>
+
+#include "abtest.h"
+#include "addon.h"
+#include "frames.h"
+#include "sweep.h"
+#include "tasks.h"
+
+// =========================
+// Dimensions
+// =========================
+// every level is 0 (low) .. 4 (cinematic); -1 leaves the setting alone
+enum dimension : int { kOverall, kShadows, kGlobalIllumination, kReflections, kPostProcessing, kDimensionCount };
+static constexpr std::array<const char *, kDimensionCount> kDimensionNames = {
+    "Overall", "Shadows", "Global illumination", "Reflections", "Post processing"};
+static constexpr int kLevels = 5;
+static constexpr std::array<const char *, kLevels> kLevelNames = {"Low", "Medium", "High", "Epic", "Cinematic"};
+static constexpr std::array<float, 4> kScales = {0.25f, 0.5f, 0.75f, 1.0f};
+
+struct scalability {
+    std::array<int, kDimensionCount> levels{-1, -1, -1, -1, -1};
+    float scale = -1.f; // normalized resolution scale
+};
+
+struct combination {
+    scalability settings;
+    int overrides = -1; // -1 untouched, 0 gate off, 1 gate on
+};
+
+static std::array<std::array<bool, kLevels>, kDimensionCount> gPickLevels{};
+static std::array<bool, kScales.size()> gPickScales{};
+static std::array<bool, 2> gPickOverrides{};
+static int gWarmup = 90; // scalability changes recreate render targets and recompile, so this is longer than A/B's
+static int gMeasure = 240;
+
+// Every group SetOverallScalabilityLevel writes, so the user's settings come back exactly whichever dimensions a sweep
+// or the hardware benchmark touched.
+struct quality_group {
+    int32_t (SDK::UGameUserSettings::*get)() const;
+    void (SDK::UGameUserSettings::*set)(int32_t);
+};
+static constexpr std::array<quality_group, 10> kQualityGroups = {{
+    {&SDK::UGameUserSettings::GetViewDistanceQuality, &SDK::UGameUserSettings::SetViewDistanceQuality},
+    {&SDK::UGameUserSettings::GetAntiAliasingQuality, &SDK::UGameUserSettings::SetAntiAliasingQuality},
+    {&SDK::UGameUserSettings::GetShadowQuality, &SDK::UGameUserSettings::SetShadowQuality},
+    {&SDK::UGameUserSettings::GetGlobalIlluminationQuality, &SDK::UGameUserSettings::SetGlobalIlluminationQuality},
+    {&SDK::UGameUserSettings::GetReflectionQuality, &SDK::UGameUserSettings::SetReflectionQuality},
+    {&SDK::UGameUserSettings::GetPostProcessingQuality, &SDK::UGameUserSettings::SetPostProcessingQuality},
+    {&SDK::UGameUserSettings::GetTextureQuality, &SDK::UGameUserSettings::SetTextureQuality},
+    {&SDK::UGameUserSettings::GetVisualEffectQuality, &SDK::UGameUserSettings::SetVisualEffectQuality},
+    {&SDK::UGameUserSettings::GetFoliageQuality, &SDK::UGameUserSettings::SetFoliageQuality},
+    {&SDK::UGameUserSettings::GetShadingQuality, &SDK::UGameUserSettings::SetShadingQuality},
+}};
+
+struct saved_settings {
+    std::array<int32_t, kQualityGroups.size()> levels{};
+    float scale = 1.f;
+};
+
+// game thread
+static std::optional<saved_settings> read_settings() {
+    auto settings = SDK::UGameUserSettings::GetGameUserSettings();
+    if (!settings)
+        return std::nullopt;
+    saved_settings out;
+    for (std::size_t g = 0; g < kQualityGroups.size(); ++g)
+        out.levels[g] = (settings->*kQualityGroups[g].get)();
+    out.scale = settings->GetResolutionScaleNormalized();
+    return out;
+}
+
+// game thread
+static void restore_settings(const saved_settings &in, bool apply) {
+    auto settings = SDK::UGameUserSettings::GetGameUserSettings();
+    if (!settings)
+        return;
+    for (std::size_t g = 0; g < kQualityGroups.size(); ++g)
+        (settings->*kQualityGroups[g].set)(in.levels[g]);
+    settings->SetResolutionScaleNormalized(in.scale);
+    if (apply)
+        settings->ApplyNonResolutionSettings();
+}
+
+// game thread; ApplyNonResolutionSettings rather than ApplySettings so nothing is saved to the user's ini
+static bool write_settings(const scalability &in, bool apply) {
+    auto settings = SDK::UGameUserSettings::GetGameUserSettings();
+    if (!settings)
+        return false;
+    if (in.levels[kOverall] >= 0)
+        settings->SetOverallScalabilityLevel(in.levels[kOverall]);
+    if (in.levels[kShadows] >= 0)
+        settings->SetShadowQuality(in.levels[kShadows]);
+    if (in.levels[kGlobalIllumination] >= 0)
+        settings->SetGlobalIlluminationQuality(in.levels[kGlobalIllumination]);
+    if (in.levels[kReflections] >= 0)
+        settings->SetReflectionQuality(in.levels[kReflections]);
+    if (in.levels[kPostProcessing] >= 0)
+        settings->SetPostProcessingQuality(in.levels[kPostProcessing]);
+    if (in.scale >= 0.f)
+        settings->SetResolutionScaleNormalized(in.scale);
+    if (apply)
+        settings->ApplyNonResolutionSettings();
+    return true;
+}
+
+// =========================
+// Run state
+// =========================
+struct measurement {
+    combination combo;
+    std::string label;
+    std::size_t frames = 0;
+    double mean = 0.0;
+    double p50 = 0.0;
+    double p95 = 0.0;
+    double p99 = 0.0;
+    double quality = 1.0; // mean normalized level over the swept dimensions
+    bool pareto = false;  // no other combination is both faster and at least as good
+};
+
+enum class phase { idle, reading, applying, measuring };
+
+static phase gPhase = phase::idle;
+static std::vector<combination> gCombos;
+static std::size_t gNext = 0;
+static std::future<std::optional<saved_settings>> gReading;
+static std::future<bool> gApplying;
+static std::optional<saved_settings> gOriginal; // empty until the reading phase returns
+static bool gOriginalEnabled = false;
+static uint64_t gStart = 0;
+static std::vector<measurement> gReport;
+static std::vector<frame_sample> gScratch;
+static std::vector<float> gMs;
+
+static std::string label_of(const combination &combo) {
+    std::string label;
+    for (int d = 0; d < kDimensionCount; ++d)
+        if (combo.settings.levels[d] >= 0)
+            label += std::string(label.empty() ? "" : ", ") + kDimensionNames[d] + " " +
+                     kLevelNames[combo.settings.levels[d]];
+    if (combo.settings.scale >= 0.f)
+        label += (label.empty() ? "" : ", ") + std::string("Scale ") +
+                 std::to_string(static_cast<int>(combo.settings.scale * 100.f + 0.5f)) + "%";
+    if (combo.overrides >= 0)
+        label += std::string(label.empty() ? "" : ", ") + (combo.overrides ? "overrides on" : "overrides off");
+    return label.empty() ? "as is" : label;
+}
+
+static double quality_of(const combination &combo) {
+    double total = 0.0;
+    int count = 0;
+    for (int d = 0; d < kDimensionCount; ++d) {
+        if (combo.settings.levels[d] >= 0) {
+            total += static_cast<double>(combo.settings.levels[d]) / (kLevels - 1);
+            ++count;
+        }
+    }
+    if (combo.settings.scale >= 0.f) {
+        total += combo.settings.scale;
+        ++count;
+    }
+    return count ? total / count : 1.0;
+}
+
+// cartesian product over the ticked values; an unticked dimension contributes a single "untouched"
+static std::vector<combination> expand() {
+    std::vector<combination> combos(1);
+    auto cross = [&](auto &&values, auto &&assign) {
+        if (values.empty())
+            return;
+        std::vector<combination> next;
+        for (const auto &combo : combos)
+            for (auto value : values) {
+                next.push_back(combo);
+                assign(next.back(), value);
+            }
+        combos = std::move(next);
+    };
+    for (int d = 0; d < kDimensionCount; ++d) {
+        std::vector<int> levels;
+        for (int level = 0; level < kLevels; ++level)
+            if (gPickLevels[d][level])
+                levels.push_back(level);
+        cross(levels, [d](combination &combo, int level) { combo.settings.levels[d] = level; });
+    }
+    std::vector<float> scales;
+    for (std::size_t i = 0; i < kScales.size(); ++i)
+        if (gPickScales[i])
+            scales.push_back(kScales[i]);
+    cross(scales, [](combination &combo, float scale) { combo.settings.scale = scale; });
+    std::vector<int> gates;
+    for (int gate = 0; gate < 2; ++gate)
+        if (gPickOverrides[gate])
+            gates.push_back(gate);
+    cross(gates, [](combination &combo, int gate) { combo.overrides = gate; });
+    return combos;
+}
+
+static void rank() {
+    for (auto &m : gReport) {
+        m.pareto = std::none_of(gReport.begin(), gReport.end(), [&](const measurement &other) {
+            return &other != &m && other.mean <= m.mean && other.quality >= m.quality &&
+                   (other.mean < m.mean || other.quality > m.quality);
+        });
+    }
+    std::ranges::sort(gReport, [](const measurement &a, const measurement &b) {
+        const auto qa = a.quality / std::max(a.mean, 1e-3);
+        const auto qb = b.quality / std::max(b.mean, 1e-3);
+        return qa != qb ? qa > qb : a.mean < b.mean;
+    });
+}
+
+static void apply_next() {
+    const auto combo = gCombos[gNext];
+    if (combo.overrides >= 0) {
+        gEnabled = combo.overrides == 1;
+        apply_overrides();
+    }
+    gApplying = RunOnGameThread([settings = combo.settings] { return write_settings(settings, true); });
+    gPhase = phase::applying;
+}
+
+static void finish(const char *why, bool restore_gate = true) {
+    gPhase = phase::idle;
+    if (gOriginal)
+        EnqueueGameTask([original = *gOriginal] { restore_settings(original, true); });
+    gOriginal.reset();
+    if (restore_gate && gEnabled != gOriginalEnabled) {
+        gEnabled = gOriginalEnabled;
+        apply_overrides();
+    }
+    rank();
+    LOG(INFO) << "Scalability sweep " << why << " after " << gReport.size() << "/" << gCombos.size()
+              << " combinations";
+    for (std::size_t i = 0; i < gReport.size(); ++i)
+        LOG(INFO) << "  #" << i + 1 << " " << gReport[i].label << ": " << gReport[i].mean << " ms mean, "
+                  << gReport[i].p99 << " ms p99, quality " << gReport[i].quality;
+}
+
+static bool ready(auto &future) { return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready; }
+
+void step_sweep() {
+    switch (gPhase) {
+    case phase::idle:
+        return;
+    case phase::reading:
+        if (!ready(gReading))
+            return;
+        gOriginal = gReading.get();
+        if (!gOriginal) {
+            finish("aborted: no GameUserSettings");
+            return;
+        }
+        apply_next();
+        return;
+    case phase::applying:
+        if (!ready(gApplying))
+            return;
+        if (!gApplying.get()) {
+            finish("aborted: GameUserSettings went away");
+            return;
+        }
+        gStart = frame_count();
+        gPhase = phase::measuring;
+        return;
+    case phase::measuring: {
+        const auto begin = gStart + static_cast<uint64_t>(gWarmup);
+        const auto end = begin + static_cast<uint64_t>(gMeasure);
+        if (frame_count() < end)
+            return;
+        const auto first = copy_frames(begin, gScratch);
+        gMs.clear();
+        double total = 0.0;
+        for (std::size_t i = 0; i < gScratch.size() && first + i < end; ++i) {
+            gMs.push_back(gScratch[i].ms);
+            total += gScratch[i].ms;
+        }
+        measurement m;
+        m.combo = gCombos[gNext];
+        m.label = label_of(m.combo);
+        m.quality = quality_of(m.combo);
+        m.frames = gMs.size();
+        if (!gMs.empty()) {
+            m.mean = total / static_cast<double>(gMs.size());
+            m.p50 = frame_percentile(gMs, 0.50f);
+            m.p95 = frame_percentile(gMs, 0.95f);
+            m.p99 = frame_percentile(gMs, 0.99f);
+        }
+        LOG(INFO) << "Sweep " << gNext + 1 << "/" << gCombos.size() << " " << m.label << ": " << m.mean << " ms";
+        gReport.push_back(std::move(m));
+        if (++gNext == gCombos.size())
+            finish("finished");
+        else
+            apply_next();
+        return;
+    }
+    }
+}
+
+bool sweep_running() { return gPhase != phase::idle; }
+
+void cancel_sweep() {
+    if (sweep_running())
+        finish("cancelled", false);
+}
+
+// =========================
+// CSV export
+// =========================
+static void export_csv() {
+    using namespace std::chrono;
+    const auto stamp = std::to_string(duration_cast<seconds>(system_clock::now().time_since_epoch()).count());
+    const auto path = std::filesystem::current_path() / ("untitled-sweep-" + stamp + ".csv");
+    std::ofstream out(path);
+    out << "rank,combination,frames,mean_ms,p50_ms,p95_ms,p99_ms,quality,quality_per_ms,pareto\n";
+    for (std::size_t i = 0; i < gReport.size(); ++i) {
+        const auto &m = gReport[i];
+        out << i + 1 << ",\"" << m.label << "\"," << m.frames << ',' << m.mean << ',' << m.p50 << ',' << m.p95 << ','
+            << m.p99 << ',' << m.quality << ',' << m.quality / std::max(m.mean, 1e-3) << ',' << m.pareto << '\n';
+    }
+    if (out)
+        LOG(INFO) << "Sweep results written to " << path.string();
+    else
+        LOG(ERROR) << "Failed to write sweep results to " << path.string();
+}
+
+// =========================
+// Overlay panel
+// =========================
+static std::future<int> gBenchmark;
+static int gRecommended = -1;
+
+void draw_sweep() {
+    const bool running = sweep_running();
+    ImGui::BeginDisabled(running);
+    for (int d = 0; d < kDimensionCount; ++d) {
+        ImGui::PushID(d);
+        ImGui::TextUnformatted(kDimensionNames[d]);
+        for (int level = 0; level < kLevels; ++level) {
+            ImGui::SameLine(level == 0 ? 160.f : 0.f);
+            ImGui::Checkbox(kLevelNames[level], &gPickLevels[d][level]);
+        }
+        ImGui::PopID();
+    }
+    ImGui::TextUnformatted("Resolution scale");
+    for (std::size_t i = 0; i < kScales.size(); ++i) {
+        ImGui::SameLine(i == 0 ? 160.f : 0.f);
+        const auto label = std::to_string(static_cast<int>(kScales[i] * 100.f)) + "%";
+        ImGui::Checkbox(label.c_str(), &gPickScales[i]);
+    }
+    ImGui::TextUnformatted("Overrides");
+    ImGui::SameLine(160.f);
+    ImGui::Checkbox("Off", &gPickOverrides[0]);
+    ImGui::SameLine();
+    ImGui::Checkbox("On", &gPickOverrides[1]);
+
+    ImGui::SliderInt("Warmup frames", &gWarmup, 0, 600);
+    ImGui::SliderInt("Measured frames", &gMeasure, 30, 2000);
+
+    const auto combos = expand();
+    const bool any = combos.size() > 1 || combos[0].settings.scale >= 0.f || combos[0].overrides >= 0 ||
+                     std::ranges::any_of(combos[0].settings.levels, [](int level) { return level >= 0; });
+    ImGui::BeginDisabled(!any || ab_test_running());
+    if (ImGui::Button("Start")) {
+        gCombos = combos;
+        gNext = 0;
+        gReport.clear();
+        gOriginalEnabled = gEnabled;
+        gOriginal.reset(); // a Stop before the read comes back has nothing to restore
+        gReading = RunOnGameThread(read_settings);
+        gPhase = phase::reading;
+        LOG(INFO) << "Scalability sweep started: " << gCombos.size() << " combinations";
+    }
+    ImGui::EndDisabled();
+    ImGui::SameLine();
+    const auto frames_each = gWarmup + gMeasure;
+    ImGui::TextDisabled("%zu combinations, ~%.0f s at 60 fps", combos.size(),
+                        static_cast<double>(combos.size() * static_cast<std::size_t>(frames_each)) / 60.0);
+
+    if (gBenchmark.valid() && ready(gBenchmark))
+        gRecommended = gBenchmark.get();
+    ImGui::BeginDisabled(gBenchmark.valid());
+    if (ImGui::Button("Hardware benchmark")) {
+        // the engine's own estimate, for picking a sensible range; the result is read, not applied
+        gBenchmark = RunOnGameThread([]() -> int {
+            auto original = read_settings();
+            auto settings = SDK::UGameUserSettings::GetGameUserSettings();
+            if (!original || !settings)
+                return -1;
+            settings->RunHardwareBenchmark(10, 1.f, 1.f);
+            const auto level = settings->GetOverallScalabilityLevel();
+            restore_settings(*original, false);
+            return level;
+        });
+    }
+    ImGui::EndDisabled();
+    if (gRecommended >= 0 && gRecommended < kLevels) {
+        ImGui::SameLine();
+        ImGui::Text("recommends %s", kLevelNames[gRecommended]);
+    }
+    ImGui::EndDisabled();
+
+    if (running) {
+        ImGui::ProgressBar(static_cast<float>(gNext) / static_cast<float>(std::max<std::size_t>(gCombos.size(), 1)));
+        ImGui::Text("%zu/%zu: %s", gNext + 1, gCombos.size(), label_of(gCombos[gNext]).c_str());
+        if (ImGui::Button("Stop"))
+            finish("stopped");
+        return;
+    }
+    if (gReport.empty())
+        return;
+
+    ImGui::Separator();
+    constexpr auto flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY;
+    if (ImGui::BeginTable("##sweep", 7, flags, ImVec2(0, 320))) {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("#");
+        ImGui::TableSetupColumn("Combination");
+        ImGui::TableSetupColumn("Mean ms");
+        ImGui::TableSetupColumn("p95 ms");
+        ImGui::TableSetupColumn("p99 ms");
+        ImGui::TableSetupColumn("Quality");
+        ImGui::TableSetupColumn("Quality/ms");
+        ImGui::TableHeadersRow();
+        for (std::size_t i = 0; i < gReport.size(); ++i) {
+            const auto &m = gReport[i];
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::Text("%zu%s", i + 1, m.pareto ? " *" : "");
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(m.label.c_str());
+            ImGui::TableNextColumn();
+            ImGui::Text("%.2f", m.mean);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.2f", m.p95);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.2f", m.p99);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.2f", m.quality);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", m.quality / std::max(m.mean, 1e-3));
+        }
+        ImGui::EndTable();
+    }
+    ImGui::TextDisabled("* on the quality/frame-time Pareto front");
+    if (ImGui::Button("Export CSV"))
+        export_csv();
+}
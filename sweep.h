@@ -0,0 +1,13 @@
+#pragma once
+
+// Scalability sweep: applies every combination of the selected UGameUserSettings quality levels (optionally crossed
+// with the override gate off/on) through the game-thread queue, measures frame times after a warmup and ranks the
+// combinations by quality per millisecond. Driven from the render thread like the A/B test.
+
+// advances a running sweep; called from reshade_present right after record_frame()
+void step_sweep();
+bool sweep_running();
+// stops and puts back the scalability settings, but leaves the override gate to whatever replaced it
+void cancel_sweep();
+
+void draw_sweep();
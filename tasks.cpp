@@ -0,0 +1,94 @@
+#include <chrono>
+#include <exception>
+
+#include <easylogging++.h>
+
+#include "tasks.h"
+
+std::atomic<uint32_t> GGameTaskBudgetUs = 500;
+std::atomic<uint64_t> GGameTasksPending = 0;
+std::atomic<uint64_t> GGameTasksRun = 0;
+std::atomic<uint64_t> GGameTaskOverruns = 0;
+
+thread_local bool TIsGameThread = false;
+
+namespace {
+
+// intrusive Vyukov MPSC queue: producers exchange the head, the consumer walks from the tail
+struct GameTask {
+    std::atomic<GameTask *> Next = nullptr;
+    std::move_only_function<void()> Run;
+};
+
+GameTask GStub;
+std::atomic<GameTask *> GHead = &GStub;
+GameTask *GTail = &GStub; // consumer only
+
+void Push(GameTask *node) {
+    node->Next.store(nullptr, std::memory_order_relaxed);
+    auto prev = GHead.exchange(node, std::memory_order_acq_rel);
+    prev->Next.store(node, std::memory_order_release);
+}
+
+// nullptr when empty, or when a producer sits between its exchange and its link; the next drain picks that up
+GameTask *Pop() {
+    auto tail = GTail;
+    auto next = tail->Next.load(std::memory_order_acquire);
+    if (tail == &GStub) {
+        if (!next)
+            return nullptr;
+        GTail = next;
+        tail = next;
+        next = next->Next.load(std::memory_order_acquire);
+    }
+    if (next) {
+        GTail = next;
+        return tail;
+    }
+    if (tail != GHead.load(std::memory_order_acquire))
+        return nullptr;
+    Push(&GStub);
+    next = tail->Next.load(std::memory_order_acquire);
+    if (next) {
+        GTail = next;
+        return tail;
+    }
+    return nullptr;
+}
+
+} // namespace
+
+void EnqueueGameTask(std::move_only_function<void()> task) {
+    auto node = new GameTask;
+    node->Run = std::move(task);
+    GGameTasksPending.fetch_add(1, std::memory_order_relaxed);
+    Push(node);
+}
+
+void DrainGameTasks() {
+    if (GGameTasksPending.load(std::memory_order_relaxed) == 0) [[likely]]
+        return;
+    TIsGameThread = true;
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto budget = std::chrono::microseconds(GGameTaskBudgetUs.load(std::memory_order_relaxed));
+    uint64_t ran = 0;
+    while (auto task = Pop()) {
+        try {
+            task->Run();
+        } catch (const std::exception &e) {
+            LOG(ERROR) << "Game-thread task threw: " << e.what();
+        } catch (...) {
+            LOG(ERROR) << "Game-thread task threw";
+        }
+        delete task;
+        ++ran;
+        GGameTasksPending.fetch_sub(1, std::memory_order_relaxed);
+        if (std::chrono::steady_clock::now() - start >= budget) {
+            if (GGameTasksPending.load(std::memory_order_relaxed) != 0)
+                GGameTaskOverruns.fetch_add(1, std::memory_order_relaxed);
+            break;
+        }
+    }
+    GGameTasksRun.fetch_add(ran, std::memory_order_relaxed);
+}
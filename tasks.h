@@ -0,0 +1,34 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <type_traits>
+#include <utility>
+
+// Work that must run on the game thread (engine mutation, UObject spawning, console commands) is queued here from any
+// thread and drained from the ProcessEvent hook at BlueprintModifyPostProcess, once per camera update.
+
+extern std::atomic<uint32_t> GGameTaskBudgetUs; // per drain; at least one task always runs
+extern std::atomic<uint64_t> GGameTasksPending;
+extern std::atomic<uint64_t> GGameTasksRun;
+extern std::atomic<uint64_t> GGameTaskOverruns; // drains that stopped on the budget with work left
+
+extern thread_local bool TIsGameThread; // set by the first drain on the game thread
+
+// multi-producer; never blocks
+extern void EnqueueGameTask(std::move_only_function<void()> task);
+// single consumer (game thread); one relaxed load when the queue is empty
+extern void DrainGameTasks();
+
+// runs inline when already on the game thread, so awaiting from a task can't deadlock
+template <typename F> auto RunOnGameThread(F &&f) -> std::future<std::invoke_result_t<std::decay_t<F>>> {
+    std::packaged_task<std::invoke_result_t<std::decay_t<F>>()> task(std::forward<F>(f));
+    auto future = task.get_future();
+    if (TIsGameThread)
+        task();
+    else
+        EnqueueGameTask(std::move(task));
+    return future;
+}
@@ -0,0 +1,316 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <unordered_map>
+
+#include <imgui.h>
+
+#include <easylogging++.h>
+
+#include <SDK/Engine_classes.hpp>
+
+#include "frames.h"
+#include "handle.h"
+#include "profiler.h"
+#include "tasks.h"
+#include "ticks.h"
+
+std::atomic<std::shared_ptr<const TickInventory>> GTickInventory;
+
+namespace {
+
+constexpr auto kSliceBudget = std::chrono::microseconds(300);
+constexpr uint32_t kClockStride = 32; // actors between budget checks; tick-enabled ones cost a ProcessEvent
+constexpr auto kRefresh = std::chrono::seconds(10); // while anything is throttled, so new spawns get throttled too
+constexpr const char *kGroupNames[] = {"PrePhysics",  "StartPhysics",  "DuringPhysics", "EndPhysics",
+                                       "PostPhysics", "PostUpdateWork", "LastDemotable", "NewlySpawned"};
+
+// class index -> the TickInterval its actors are raised to; edited by the overlay, read by the game thread
+using ThrottleMap = std::unordered_map<int32_t, float>;
+std::atomic<std::shared_ptr<const ThrottleMap>> GThrottle = std::make_shared<const ThrottleMap>();
+
+std::atomic_bool GRequested = false;
+std::atomic_bool GRunning = false;
+
+// =========================
+// Pass in progress (game thread)
+// =========================
+struct Throttled {
+    ObjectHandle Actor;
+    int32_t ClassIndex;
+    float Original;
+};
+
+struct Pass {
+    std::vector<ObjectHandle> Levels;
+    uint32_t Level = 0;
+    int32_t Actor = 0;
+    std::unordered_map<int32_t, TickClassRow> Rows;
+    std::unordered_map<int32_t, std::array<uint32_t, 8>> Groups;
+    std::shared_ptr<const ThrottleMap> Throttle;
+    TickInventory Result;
+};
+Pass GPass;
+uint64_t GPassNumber = 0;
+std::chrono::steady_clock::time_point GLastFinished;
+std::unordered_map<int32_t, Throttled> GThrottled; // by actor index; what to restore
+
+void Begin() {
+    auto world = SDK::UWorld::GetWorld();
+    if (!world)
+        return;
+    GPass = {};
+    GPass.Throttle = GThrottle.load(std::memory_order_acquire);
+    GPass.Result.Number = ++GPassNumber;
+    std::erase_if(GThrottled, [](const auto &entry) { return !entry.second.Actor.Get(); }); // destroyed since
+    for (int32_t i = 0; i < world->levels.Num(); ++i)
+        if (auto level = world->levels[i])
+            GPass.Levels.push_back(ObjectHandle::Of(level));
+    GRunning.store(true, std::memory_order_relaxed);
+}
+
+void Visit(SDK::AActor *actor) {
+    const auto &tick = actor->PrimaryActorTick;
+    const auto type = actor->Class;
+    auto &row = GPass.Rows.try_emplace(type->Index, TickClassRow{type, type->Index}).first->second;
+    ++row.Actors;
+    ++GPass.Result.Actors;
+    if (!tick.bCanEverTick)
+        return;
+    ++row.CanTick;
+
+    if (auto throttle = GPass.Throttle->find(type->Index);
+        throttle != GPass.Throttle->end() && tick.TickInterval < throttle->second) {
+        GThrottled.try_emplace(actor->Index, Throttled{ObjectHandle::Of(actor), type->Index, tick.TickInterval});
+        actor->SetActorTickInterval(throttle->second);
+    }
+    // the enabled state lives in FTickFunction's private TickState, so ask the engine
+    if (!actor->IsActorTickEnabled())
+        return;
+    ++row.Enabled;
+    if (tick.TickInterval <= 0.f) {
+        ++row.EveryFrame;
+    } else {
+        row.IntervalRate += 1.0 / tick.TickInterval;
+        row.MinInterval = row.MinInterval > 0.f ? std::min(row.MinInterval, tick.TickInterval) : tick.TickInterval;
+    }
+    const auto group = static_cast<std::size_t>(tick.TickGroup);
+    if (group < 8)
+        ++GPass.Groups[type->Index][group];
+}
+
+// one actor per call; false once every level is done
+bool Step() {
+    if (GPass.Level >= GPass.Levels.size())
+        return false;
+    auto level = GPass.Levels[GPass.Level].Get<SDK::ULevel>();
+    if (!level || GPass.Actor >= level->Actors.Num()) {
+        ++GPass.Level;
+        GPass.Actor = 0;
+        return true;
+    }
+    if (auto actor = level->Actors[GPass.Actor++]; actor && actor->Class && !actor->IsDefaultObject())
+        Visit(actor);
+    return true;
+}
+
+void Finish() {
+    auto &result = GPass.Result;
+    for (auto &[index, row] : GPass.Rows) {
+        if (row.CanTick == 0)
+            continue;
+        if (auto groups = GPass.Groups.find(index); groups != GPass.Groups.end())
+            row.TickGroup = static_cast<uint8_t>(std::ranges::max_element(groups->second) - groups->second.begin());
+        row.Name = row.Class->GetName();
+        result.Rows.push_back(std::move(row));
+    }
+    LOG(INFO) << "Tick inventory #" << result.Number << ": " << result.Actors << " actors, " << result.Rows.size()
+              << " classes can tick, " << result.Slices << " slices, " << result.GameThreadMs << " ms game thread";
+    GTickInventory.store(std::make_shared<const TickInventory>(std::move(result)), std::memory_order_release);
+    GPass = {};
+    GLastFinished = std::chrono::steady_clock::now();
+    GRunning.store(false, std::memory_order_relaxed);
+}
+
+// game thread: puts back the intervals of actors whose class is no longer throttled
+void Restore(std::shared_ptr<const ThrottleMap> throttle) {
+    uint32_t restored = 0;
+    std::erase_if(GThrottled, [&](const std::pair<const int32_t, Throttled> &entry) {
+        const auto &throttled = entry.second;
+        if (throttle->contains(throttled.ClassIndex))
+            return false;
+        if (auto actor = throttled.Actor.Get<SDK::AActor>()) {
+            actor->SetActorTickInterval(throttled.Original);
+            ++restored;
+        }
+        return true;
+    });
+    if (restored)
+        LOG(INFO) << "Restored the tick interval of " << restored << " actors";
+}
+
+} // namespace
+
+void RequestTickInventory() { GRequested.store(true, std::memory_order_relaxed); }
+
+void StepTickInventory() {
+    if (!GRunning.load(std::memory_order_relaxed)) {
+        const bool refresh = !GThrottled.empty() || !GThrottle.load(std::memory_order_relaxed)->empty();
+        if (GRequested.exchange(false, std::memory_order_relaxed) ||
+            (refresh && std::chrono::steady_clock::now() - GLastFinished > kRefresh))
+            Begin();
+        return;
+    }
+    // the overlay may have unthrottled a class since the last slice; its Restore task must not be undone
+    GPass.Throttle = GThrottle.load(std::memory_order_acquire);
+    const auto start = std::chrono::steady_clock::now();
+    bool more = true;
+    for (uint32_t done = 1; more; ++done) {
+        more = Step();
+        if (done % kClockStride == 0 && std::chrono::steady_clock::now() - start >= kSliceBudget)
+            break;
+    }
+    ++GPass.Result.Slices;
+    GPass.Result.GameThreadMs +=
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    if (!more)
+        Finish();
+}
+
+// =========================
+// Overlay panel
+// =========================
+void DrawTickInventory() {
+    static float throttleInterval = 0.1f;
+    static std::shared_ptr<const TickInventory> shown;
+    static std::unordered_map<int32_t, ProfilerRow> receiveTicks; // by owning class index, see below
+    static std::chrono::steady_clock::time_point refreshed{};
+
+    ImGui::BeginDisabled(GRunning.load(std::memory_order_relaxed));
+    if (ImGui::Button("Take inventory"))
+        RequestTickInventory();
+    ImGui::EndDisabled();
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(160.f);
+    ImGui::SliderFloat("Throttled interval", &throttleInterval, 0.02f, 2.f, "%.2f s", ImGuiSliderFlags_Logarithmic);
+    if (ImGui::IsItemHovered())
+        ImGui::SetTooltip("TickInterval given to actors of the classes ticked in the Throttle column");
+
+    shown = GTickInventory.load(std::memory_order_acquire);
+    if (!shown)
+        return;
+
+    // frame rate bounds how often an every-frame ticker runs
+    static std::vector<frame_sample> frames;
+    const auto count = frame_count();
+    copy_frames(count > 120 ? count - 120 : 0, frames);
+    double total = 0.0;
+    for (const auto &frame : frames)
+        total += frame.ms;
+    const double fps = total > 0.0 ? 1000.0 * static_cast<double>(frames.size()) / total : 60.0;
+
+    // ReceiveTick is the Blueprint tick event; each Blueprint class that implements it owns its own UFunction
+    const auto now = std::chrono::steady_clock::now();
+    if (now - refreshed > std::chrono::milliseconds(500)) {
+        refreshed = now;
+        receiveTicks.clear();
+        for (auto &row : ProfilerCollect())
+            if (row.OuterIndex >= 0 && row.Name.ends_with(":ReceiveTick"))
+                receiveTicks.emplace(row.OuterIndex, std::move(row));
+    }
+    auto receiveTick = [&](int32_t classIndex) -> const ProfilerRow * {
+        const auto it = receiveTicks.find(classIndex);
+        return it != receiveTicks.end() ? &it->second : nullptr;
+    };
+
+    struct Ranked {
+        const TickClassRow *Row;
+        const ProfilerRow *Profile;
+        double TicksPerSecond;
+        double CostMsPerSecond; // ReceiveTick mean times tick rate; 0 without profiler data
+    };
+    std::vector<Ranked> ranked;
+    for (const auto &row : shown->Rows) {
+        const auto rate = row.EveryFrame * fps + std::min(row.IntervalRate, row.Enabled * fps);
+        const auto profile = receiveTick(row.ClassIndex);
+        ranked.push_back({&row, profile, rate, profile ? profile->MeanUs * rate / 1000.0 : 0.0});
+    }
+    std::ranges::sort(ranked, [](const Ranked &a, const Ranked &b) {
+        return a.CostMsPerSecond != b.CostMsPerSecond ? a.CostMsPerSecond > b.CostMsPerSecond
+                                                      : a.TicksPerSecond > b.TicksPerSecond;
+    });
+
+    ImGui::Text("Inventory #%llu: %llu actors, %zu classes can tick (%u slices, %.2f ms on the game thread)",
+                static_cast<unsigned long long>(shown->Number), static_cast<unsigned long long>(shown->Actors),
+                shown->Rows.size(), shown->Slices, shown->GameThreadMs);
+    if (!GProfilerEnabled.load(std::memory_order_relaxed))
+        ImGui::TextDisabled("Enable the ProcessEvent profiler to rank by ReceiveTick time");
+
+    auto throttle = GThrottle.load(std::memory_order_acquire);
+    std::shared_ptr<ThrottleMap> edited;
+    constexpr auto flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY;
+    if (ImGui::BeginTable("##ticks", 9, flags, ImVec2(0, 320))) {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("Class");
+        ImGui::TableSetupColumn("Actors");
+        ImGui::TableSetupColumn("Enabled");
+        ImGui::TableSetupColumn("Every frame");
+        ImGui::TableSetupColumn("Min interval");
+        ImGui::TableSetupColumn("Group");
+        ImGui::TableSetupColumn("Ticks/s");
+        ImGui::TableSetupColumn("ReceiveTick ms/s");
+        ImGui::TableSetupColumn("Throttle");
+        ImGui::TableHeadersRow();
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(ranked.size()));
+        while (clipper.Step()) {
+            for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i) {
+                const auto &[row, profile, rate, cost] = ranked[i];
+                ImGui::PushID(row->ClassIndex);
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(row->Name.c_str());
+                ImGui::TableNextColumn();
+                ImGui::Text("%u", row->Actors);
+                ImGui::TableNextColumn();
+                ImGui::Text("%u / %u", row->Enabled, row->CanTick);
+                ImGui::TableNextColumn();
+                ImGui::Text("%u", row->EveryFrame);
+                ImGui::TableNextColumn();
+                if (row->MinInterval > 0.f)
+                    ImGui::Text("%.2f s", row->MinInterval);
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(kGroupNames[row->TickGroup]);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.0f", rate);
+                ImGui::TableNextColumn();
+                if (profile) {
+                    ImGui::Text("%.3f", cost);
+                    if (ImGui::IsItemHovered())
+                        ImGui::SetTooltip("%llu calls, mean %.1f us, p99 %.1f us",
+                                          static_cast<unsigned long long>(profile->Calls), profile->MeanUs,
+                                          profile->P99Us);
+                }
+                ImGui::TableNextColumn();
+                bool throttled = throttle->contains(row->ClassIndex);
+                if (ImGui::Checkbox("##throttle", &throttled)) {
+                    if (!edited)
+                        edited = std::make_shared<ThrottleMap>(*throttle);
+                    if (throttled)
+                        (*edited)[row->ClassIndex] = throttleInterval;
+                    else
+                        edited->erase(row->ClassIndex);
+                    LOG(INFO) << (throttled ? "Throttling " : "Unthrottling ") << row->Name;
+                }
+                ImGui::PopID();
+            }
+        }
+        ImGui::EndTable();
+    }
+    if (edited) {
+        std::shared_ptr<const ThrottleMap> published = std::move(edited);
+        GThrottle.store(published, std::memory_order_release);
+        EnqueueGameTask([published] { Restore(published); });
+        RequestTickInventory(); // applies the new throttle to the actors already out there
+    }
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace SDK {
+class UClass;
+}
+
+// Tick inventory: walks ULevel::Actors in game-thread slices, reads each actor's PrimaryActorTick and aggregates it
+// per class. The overlay joins the result with the ProcessEvent profiler's ReceiveTick rows, which only see
+// Blueprint ticks; native Tick() never goes through ProcessEvent.
+//
+// Throttling raises TickInterval (through SetActorTickInterval) on every actor of the selected classes, including
+// ones spawned later, which the next inventory pass picks up. Unselecting a class restores the intervals it had.
+
+struct TickClassRow {
+    SDK::UClass *Class;
+    int32_t ClassIndex;
+    std::string Name;
+    uint32_t Actors = 0;
+    uint32_t CanTick = 0; // bCanEverTick
+    uint32_t Enabled = 0; // IsActorTickEnabled()
+    uint32_t EveryFrame = 0; // enabled with TickInterval 0
+    double IntervalRate = 0.0; // sum of 1 / TickInterval over the enabled actors that have one
+    float MinInterval = 0.f;   // over the enabled actors that have one
+    uint8_t TickGroup = 0;     // most common among the enabled actors
+};
+
+struct TickInventory {
+    uint64_t Number = 0;
+    std::vector<TickClassRow> Rows; // classes with at least one actor that can tick
+    uint64_t Actors = 0;
+    uint32_t Slices = 0;
+    double GameThreadMs = 0.0;
+};
+
+extern std::atomic<std::shared_ptr<const TickInventory>> GTickInventory;
+
+// any thread; a request made while a pass is in progress starts another one after it
+extern void RequestTickInventory();
+// game thread, once per camera update
+extern void StepTickInventory();
+extern void DrawTickInventory();
@@ -0,0 +1,100 @@
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <string>
+
+#include "preview.h"
+
+// =========================
+// PFM
+// =========================
+// "PF\n<width> <height>\n<scale>\n" then raw floats, rows bottom to top; a negative scale means little endian
+std::optional<image> read_pfm(const std::filesystem::path &path) {
+    std::ifstream in(path, std::ios::binary);
+    std::string magic;
+    int width = 0, height = 0;
+    double scale = 0.0;
+    if (!(in >> magic >> width >> height >> scale) || in.get() == EOF) {
+        std::fprintf(stderr, "%s: not a PFM file\n", path.string().c_str());
+        return std::nullopt;
+    }
+    if (magic != "PF" || width <= 0 || height <= 0 || scale == 0.0) {
+        std::fprintf(stderr, "%s: only color PFM files are supported\n", path.string().c_str());
+        return std::nullopt;
+    }
+
+    image img{width, height, std::vector<float>(static_cast<std::size_t>(width) * height * 3)};
+    const std::size_t row = static_cast<std::size_t>(width) * 3;
+    for (int y = height - 1; y >= 0; --y)
+        in.read(reinterpret_cast<char *>(img.pixels.data() + y * row), static_cast<std::streamsize>(row * 4));
+    if (!in) {
+        std::fprintf(stderr, "%s: truncated\n", path.string().c_str());
+        return std::nullopt;
+    }
+
+    if ((scale < 0.0) != (std::endian::native == std::endian::little))
+        for (auto &v : img.pixels)
+            v = std::bit_cast<float>(std::byteswap(std::bit_cast<uint32_t>(v)));
+    return img;
+}
+
+bool write_pfm(const std::filesystem::path &path, const image &img) {
+    std::ofstream out(path, std::ios::binary);
+    out << "PF\n" << img.width << ' ' << img.height << '\n' << (std::endian::native == std::endian::little ? -1 : 1)
+        << ".0\n";
+    const std::size_t row = static_cast<std::size_t>(img.width) * 3;
+    for (int y = img.height - 1; y >= 0; --y)
+        out.write(reinterpret_cast<const char *>(img.pixels.data() + y * row), static_cast<std::streamsize>(row * 4));
+    if (!out)
+        std::fprintf(stderr, "Failed to write %s\n", path.string().c_str());
+    return static_cast<bool>(out);
+}
+
+// =========================
+// PPM
+// =========================
+bool write_ppm(const std::filesystem::path &path, const image &img) {
+    std::vector<unsigned char> bytes(img.pixels.size());
+    std::ranges::transform(img.pixels, bytes.begin(), [](float v) {
+        return static_cast<unsigned char>(std::lround(std::clamp(v, 0.f, 1.f) * 255.f));
+    });
+    std::ofstream out(path, std::ios::binary);
+    out << "P6\n" << img.width << ' ' << img.height << "\n255\n";
+    out.write(reinterpret_cast<const char *>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    if (!out)
+        std::fprintf(stderr, "Failed to write %s\n", path.string().c_str());
+    return static_cast<bool>(out);
+}
+
+// =========================
+// Diff
+// =========================
+diff_stats diff(const image &a, const image &b) {
+    diff_stats stats;
+    const std::size_t pixels = a.pixels.size() / 3;
+    if (pixels == 0)
+        return stats;
+
+    double sum = 0.0, squares = 0.0;
+    std::size_t over = 0;
+    for (std::size_t i = 0; i < pixels; ++i) {
+        double worst = 0.0;
+        for (int c = 0; c < 3; ++c) {
+            const double d = std::abs(static_cast<double>(a.pixels[i * 3 + c]) - b.pixels[i * 3 + c]);
+            sum += d;
+            squares += d * d;
+            worst = std::max(worst, d);
+        }
+        stats.max_abs = std::max(stats.max_abs, worst);
+        over += worst > 1.0 / 255.0;
+    }
+    stats.mean_abs = sum / (pixels * 3);
+    stats.rmse = std::sqrt(squares / (pixels * 3));
+    stats.psnr = stats.rmse > 0.0 ? -20.0 * std::log10(stats.rmse) : std::numeric_limits<double>::infinity();
+    stats.over_one_step = static_cast<double>(over) / pixels;
+    return stats;
+}
@@ -0,0 +1,113 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "preview.h"
+
+static constexpr const char *kUsage =
+    "usage:\n"
+    "  untitled-preview render <preset.ini> <frame.pfm> <out.ppm|out.pfm> [options]\n"
+    "  untitled-preview diff <a.ini> <b.ini> <frame.pfm>... [options]\n"
+    "\n"
+    "A preset of \"-\" leaves every setting at the engine value.\n"
+    "\n"
+    "options:\n"
+    "  --threads <n>     workers, default: every hardware thread\n"
+    "  --max-diff <n>    diff: exit with 1 when any channel differs by more than n 8-bit steps\n";
+
+struct options {
+    std::vector<std::string> args;
+    unsigned threads = std::max(std::thread::hardware_concurrency(), 1u);
+    double max_diff = -1.0;
+};
+
+static std::optional<preview_settings> load(const std::string &preset) {
+    if (preset == "-")
+        return preview_settings{};
+    return read_preset(preset);
+}
+
+// renders and reports the throughput on stderr, keeping stdout for results
+static image timed_render(const image &frame, const preview_settings &settings, unsigned threads) {
+    const auto start = std::chrono::steady_clock::now();
+    image out = render(frame, settings, threads);
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::fprintf(stderr, "  %dx%d in %.2f ms (%.1f Mpx/s, %u threads)\n", frame.width, frame.height, ms,
+                 frame.width * static_cast<double>(frame.height) / (ms * 1e3), threads);
+    return out;
+}
+
+static int run_render(const options &opt) {
+    if (opt.args.size() != 3) {
+        std::fputs(kUsage, stderr);
+        return 2;
+    }
+    const auto settings = load(opt.args[0]);
+    const auto frame = read_pfm(opt.args[1]);
+    if (!settings || !frame)
+        return 1;
+
+    const std::filesystem::path out = opt.args[2];
+    const image result = timed_render(*frame, *settings, opt.threads);
+    return (out.extension() == ".pfm" ? write_pfm(out, result) : write_ppm(out, result)) ? 0 : 1;
+}
+
+static int run_diff(const options &opt) {
+    if (opt.args.size() < 3) {
+        std::fputs(kUsage, stderr);
+        return 2;
+    }
+    const auto a = load(opt.args[0]), b = load(opt.args[1]);
+    if (!a || !b)
+        return 1;
+
+    std::printf("frame,mean_abs,max_abs,max_steps,rmse,psnr_db,over_one_step\n");
+    bool failed = false;
+    for (std::size_t i = 2; i < opt.args.size(); ++i) {
+        const auto frame = read_pfm(opt.args[i]);
+        if (!frame) {
+            failed = true;
+            continue;
+        }
+        std::fprintf(stderr, "%s\n", opt.args[i].c_str());
+        const diff_stats d = diff(timed_render(*frame, *a, opt.threads), timed_render(*frame, *b, opt.threads));
+        std::printf("\"%s\",%.6f,%.6f,%.0f,%.6f,%.2f,%.6f\n", opt.args[i].c_str(), d.mean_abs, d.max_abs,
+                    d.max_abs * 255.0, d.rmse, d.psnr, d.over_one_step);
+        if (opt.max_diff >= 0.0 && d.max_abs * 255.0 > opt.max_diff + 1e-6)
+            failed = true;
+    }
+    return failed ? 1 : 0;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        std::fputs(kUsage, stderr);
+        return 2;
+    }
+
+    options opt;
+    for (int i = 2; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if ((arg == "--threads" || arg == "--max-diff") && i + 1 < argc) {
+            const double value = std::atof(argv[++i]);
+            if (arg == "--threads")
+                opt.threads = static_cast<unsigned>(std::max(value, 1.0));
+            else
+                opt.max_diff = value;
+        } else {
+            opt.args.emplace_back(arg);
+        }
+    }
+
+    const std::string_view command = argv[1];
+    if (command == "render")
+        return run_render(opt);
+    if (command == "diff")
+        return run_diff(opt);
+    std::fputs(kUsage, stderr);
+    return 2;
+}
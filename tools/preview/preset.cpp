@@ -0,0 +1,81 @@
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <string>
+#include <string_view>
+
+#include "preview.h"
+
+// keys and section as the add-on writes them (schema.h: kSection, Node::key_enabled / key_value)
+static constexpr std::string_view kSection = "untitled";
+
+static constexpr struct {
+    std::string_view key;
+    float preview_settings::*field;
+} kFields[] = {
+    {"AutoExposureBias", &preview_settings::exposure_bias},
+    {"WhiteTemp", &preview_settings::white_temp},
+    {"WhiteTint", &preview_settings::white_tint},
+    {"FilmSlope", &preview_settings::film_slope},
+    {"FilmToe", &preview_settings::film_toe},
+    {"FilmShoulder", &preview_settings::film_shoulder},
+    {"FilmBlackClip", &preview_settings::film_black_clip},
+    {"FilmWhiteClip", &preview_settings::film_white_clip},
+    {"ToneCurveAmount", &preview_settings::tone_curve_amount},
+    {"VignetteIntensity", &preview_settings::vignette_intensity},
+};
+
+static std::string_view trim(std::string_view s) {
+    const auto first = s.find_first_not_of(" \t\r");
+    if (first == std::string_view::npos)
+        return {};
+    return s.substr(first, s.find_last_not_of(" \t\r") - first + 1);
+}
+
+std::optional<preview_settings> read_preset(const std::filesystem::path &path) {
+    std::ifstream in(path);
+    if (!in) {
+        std::fprintf(stderr, "Failed to open %s\n", path.string().c_str());
+        return std::nullopt;
+    }
+
+    std::map<std::string, std::string, std::less<>> values;
+    bool in_section = false;
+    for (std::string line; std::getline(in, line);) {
+        const auto text = trim(line);
+        if (text.empty() || text.front() == ';' || text.front() == '#')
+            continue;
+        if (text.front() == '[') {
+            in_section = text.ends_with(']') && text.substr(1, text.size() - 2) == kSection;
+            continue;
+        }
+        const auto eq = text.find('=');
+        if (in_section && eq != std::string_view::npos)
+            values.emplace(trim(text.substr(0, eq)), trim(text.substr(eq + 1)));
+    }
+
+    const auto flag = [&](const std::string &key) {
+        const auto it = values.find(key);
+        return it != values.end() && std::atoi(it->second.c_str()) != 0;
+    };
+
+    preview_settings settings;
+    if (!flag("Enabled"))
+        return settings;
+    for (const auto &[key, field] : kFields) {
+        const std::string name(key);
+        const auto value = values.find(name + ".Value");
+        if (!flag(name + ".Enabled") || value == values.end())
+            continue;
+        char *end = nullptr;
+        const float v = std::strtof(value->second.c_str(), &end);
+        if (end == value->second.c_str()) {
+            std::fprintf(stderr, "%s: %s is not a number, keeping the engine value\n", path.string().c_str(),
+                         value->first.c_str());
+            continue;
+        }
+        settings.*field = v;
+    }
+    return settings;
+}
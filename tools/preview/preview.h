@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <vector>
+
+// Offline preview of the cheap, deterministic part of the post-process chain, for diffing presets without the game.
+// A frame is linear scene color captured before exposure (PFM); per pixel, in the order the engine applies them:
+//  1. exposure: AutoExposureBias, as exp2 of the bias; auto exposure itself is not simulated
+//  2. vignette: VignetteIntensity, the cosine-fourth falloff of ComputeVignetteMask
+//  3. white balance: WhiteTemp / WhiteTint, a CAT02 adaptation from the selected white to D65
+//  4. film tonemapper: FilmSlope / FilmToe / FilmShoulder / FilmBlackClip / FilmWhiteClip in ACEScg, blended with
+//     ToneCurveAmount; the ACES glow and red modifiers, color grading and gamut expansion are left out
+//  5. output: clamp to [0, 1] and sRGB encoding
+// so the output approximates the engine's image rather than reproducing it; two presets go through the same
+// approximation, which is what makes their difference meaningful.
+
+// values the engine uses for settings the preset does not override
+struct preview_settings {
+    float exposure_bias = 0.f;
+    float white_temp = 6500.f;
+    float white_tint = 0.f;
+    float film_slope = 0.88f;
+    float film_toe = 0.55f;
+    float film_shoulder = 0.26f;
+    float film_black_clip = 0.f;
+    float film_white_clip = 0.04f;
+    float tone_curve_amount = 1.f;
+    float vignette_intensity = 0.4f;
+};
+
+// interleaved RGB floats, rows top to bottom
+struct image {
+    int width = 0;
+    int height = 0;
+    std::vector<float> pixels;
+};
+
+struct diff_stats {
+    double mean_abs = 0.0; // over every channel of every pixel, on sRGB-encoded [0, 1] values
+    double max_abs = 0.0;
+    double rmse = 0.0;
+    double psnr = 0.0; // dB against a peak of 1; infinite for identical images
+    double over_one_step = 0.0; // fraction of pixels with a channel differing by more than 1/255
+};
+
+// image.cpp
+extern std::optional<image> read_pfm(const std::filesystem::path &path);
+extern bool write_pfm(const std::filesystem::path &path, const image &img);
+extern bool write_ppm(const std::filesystem::path &path, const image &img); // 8 bit, values already encoded
+extern diff_stats diff(const image &a, const image &b);
+
+// preset.cpp; reads the add-on's section of a ReShade preset. Overrides that are disabled, or every override when
+// the global Enabled is off, keep the engine value.
+extern std::optional<preview_settings> read_preset(const std::filesystem::path &path);
+
+// render.cpp; tiles of rows spread over `threads` workers (including the caller)
+extern image render(const image &src, const preview_settings &settings, unsigned threads);
@@ -0,0 +1,274 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+#include "preview.h"
+
+// =========================
+// Color
+// =========================
+using mat3 = std::array<double, 9>;
+
+static mat3 mul(const mat3 &a, const mat3 &b) {
+    mat3 m{};
+    for (int r = 0; r < 3; ++r)
+        for (int c = 0; c < 3; ++c)
+            m[r * 3 + c] = a[r * 3] * b[c] + a[r * 3 + 1] * b[3 + c] + a[r * 3 + 2] * b[6 + c];
+    return m;
+}
+
+static mat3 inverse(const mat3 &m) {
+    const mat3 cofactors{
+        m[4] * m[8] - m[5] * m[7], m[2] * m[7] - m[1] * m[8], m[1] * m[5] - m[2] * m[4],
+        m[5] * m[6] - m[3] * m[8], m[0] * m[8] - m[2] * m[6], m[2] * m[3] - m[0] * m[5],
+        m[3] * m[7] - m[4] * m[6], m[1] * m[6] - m[0] * m[7], m[0] * m[4] - m[1] * m[3],
+    };
+    const double det = m[0] * cofactors[0] + m[1] * cofactors[3] + m[2] * cofactors[6];
+    mat3 inv{};
+    for (int i = 0; i < 9; ++i)
+        inv[i] = cofactors[i] / det;
+    return inv;
+}
+
+static constexpr mat3 kSrgbToXyz{
+    0.4124564, 0.3575761, 0.1804375, //
+    0.2126729, 0.7151522, 0.0721750, //
+    0.0193339, 0.1191920, 0.9503041,
+};
+static constexpr mat3 kXyzToCat02{
+    0.7328,  0.4296, -0.1624, //
+    -0.7036, 1.6975, 0.0061,  //
+    0.0030,  0.0136, 0.9834,
+};
+// ACEScg (AP1, D60), with the Bradford D65 <-> D60 adaptation folded in
+static constexpr mat3 kSrgbToAp1{
+    0.6130974024, 0.3395231462, 0.0473794514, //
+    0.0701937225, 0.9163538791, 0.0134523985, //
+    0.0206155929, 0.1095697729, 0.8698146342,
+};
+static constexpr mat3 kAp1ToSrgb{
+    1.7048586763,  -0.6217160219, -0.0831426544, //
+    -0.1300768242, 1.1407357748,  -0.0106589506, //
+    -0.0239640729, -0.1289755083, 1.1529395812,
+};
+static constexpr std::array<float, 3> kAp1Luma{0.2722287168f, 0.6740817658f, 0.0536895174f};
+
+struct xy {
+    double x, y;
+};
+
+// the engine's WhiteBalance(): daylight locus above 4000 K, Planckian below, tint along the isotherm
+static xy daylight_white(double temp) {
+    temp *= 1.4388 / 1.438;
+    const double inv = 1.0 / temp;
+    const double x = temp <= 7000.0 ? 0.244063 + (0.09911e3 + (2.9678e6 - 4.6070e9 * inv) * inv) * inv
+                                    : 0.237040 + (0.24748e3 + (1.9018e6 - 2.0064e9 * inv) * inv) * inv;
+    return {x, -3.0 * x * x + 2.87 * x - 0.275};
+}
+
+static xy planckian_white(double temp, double tint) {
+    const double t2 = temp * temp;
+    double u = (0.860117757 + 1.54118254e-4 * temp + 1.28641212e-7 * t2) /
+               (1.0 + 8.42420235e-4 * temp + 7.08145163e-7 * t2);
+    double v = (0.317398726 + 4.22806245e-5 * temp + 4.20481691e-8 * t2) /
+               (1.0 - 2.89741816e-5 * temp + 1.61456053e-7 * t2);
+    if (tint != 0.0) {
+        const double ud = (-1.13758118e9 - 1.91615621e6 * temp - 1.53177 * t2) /
+                          std::pow(1.41213984e6 + 1189.62 * temp + t2, 2.0);
+        const double vd = (1.97471536e9 - 705674.0 * temp - 308.607 * t2) /
+                          std::pow(6.19363586e6 - 179.456 * temp + t2, 2.0);
+        const double len = std::hypot(ud, vd);
+        u += -vd / len * tint * 0.05;
+        v += ud / len * tint * 0.05;
+    }
+    const double d = 2.0 * u - 8.0 * v + 4.0;
+    return {3.0 * u / d, 2.0 * v / d};
+}
+
+static mat3 white_balance(double temp, double tint) {
+    xy src = temp < 4000.0 ? planckian_white(temp, 0.0) : daylight_white(temp);
+    const xy plankian = planckian_white(temp, 0.0), isothermal = planckian_white(temp, tint);
+    src.x += isothermal.x - plankian.x;
+    src.y += isothermal.y - plankian.y;
+    constexpr xy kD65{0.31270, 0.32900};
+
+    const auto lms = [](xy w) {
+        const mat3 &m = kXyzToCat02;
+        const double X = w.x / w.y, Z = (1.0 - w.x - w.y) / w.y;
+        return std::array{m[0] * X + m[1] + m[2] * Z, m[3] * X + m[4] + m[5] * Z, m[6] * X + m[7] + m[8] * Z};
+    };
+    const auto from = lms(src), to = lms(kD65);
+    const mat3 scale{to[0] / from[0], 0, 0, 0, to[1] / from[1], 0, 0, 0, to[2] / from[2]};
+    const mat3 adapt = mul(inverse(kXyzToCat02), mul(scale, kXyzToCat02));
+    return mul(inverse(kSrgbToXyz), mul(adapt, kSrgbToXyz));
+}
+
+// =========================
+// Stages
+// =========================
+// everything derived from the preset once per frame; the per-pixel loops below only see floats
+struct params {
+    float exposure;
+    std::array<float, 9> to_working; // white balance, then sRGB -> AP1
+    std::array<float, 9> to_output;  // AP1 -> sRGB
+    float tone_amount;
+    // vignette: circle-space position of pixel (x, y) is (x * sx + bx, y * sy + by), already scaled by intensity
+    float sx, bx, sy, by;
+    // film curve, as FilmToneMap() lays it out in log10 space
+    float slope, toe_scale, shoulder_scale, black_clip, white_clip;
+    float toe_match, straight_match, shoulder_match;
+    float blend_scale, blend_bias; // toe -> shoulder blend weight before smoothstep, flipped when they cross
+};
+
+static params prepare(const preview_settings &s, int width, int height) {
+    params p{};
+    p.exposure = std::exp2(s.exposure_bias);
+
+    const mat3 working = s.white_temp != 6500.f || s.white_tint != 0.f
+                             ? mul(kSrgbToAp1, white_balance(s.white_temp, s.white_tint))
+                             : kSrgbToAp1;
+    std::ranges::transform(working, p.to_working.begin(), [](double v) { return static_cast<float>(v); });
+    std::ranges::transform(kAp1ToSrgb, p.to_output.begin(), [](double v) { return static_cast<float>(v); });
+    p.tone_amount = std::clamp(s.tone_curve_amount, 0.f, 1.f);
+
+    // VignetteSpace(): a circle in pixel space whose corners sit at sqrt(2)
+    const double aspect = static_cast<double>(height) / width;
+    const double scale = std::sqrt(2.0) / std::sqrt(1.0 + aspect * aspect) * s.vignette_intensity;
+    p.sx = static_cast<float>(2.0 / width * scale);
+    p.bx = static_cast<float>((1.0 / width - 1.0) * scale);
+    p.sy = static_cast<float>(2.0 / height * aspect * scale);
+    p.by = static_cast<float>((1.0 / height - 1.0) * aspect * scale);
+
+    const double slope = std::max(s.film_slope, 1e-3f), toe = s.film_toe, shoulder = s.film_shoulder;
+    const double black_clip = s.film_black_clip, white_clip = s.film_white_clip;
+    const double toe_scale = 1.0 + black_clip - toe;
+    const double shoulder_scale = 1.0 + white_clip - shoulder;
+    constexpr double kInMatch = 0.18, kOutMatch = 0.18;
+    double toe_match;
+    if (toe > 0.8) {
+        toe_match = (1.0 - toe - kOutMatch) / slope + std::log10(kInMatch);
+    } else {
+        const double bt = (kOutMatch + black_clip) / toe_scale - 1.0;
+        toe_match = std::log10(kInMatch) - 0.5 * std::log((1.0 + bt) / (1.0 - bt)) * (toe_scale / slope);
+    }
+    const double straight_match = (1.0 - toe) / slope - toe_match;
+    const double shoulder_match = shoulder / slope - straight_match;
+
+    p.slope = static_cast<float>(slope);
+    p.toe_scale = static_cast<float>(toe_scale);
+    p.shoulder_scale = static_cast<float>(shoulder_scale);
+    p.black_clip = static_cast<float>(black_clip);
+    p.white_clip = static_cast<float>(white_clip);
+    p.toe_match = static_cast<float>(toe_match);
+    p.straight_match = static_cast<float>(straight_match);
+    p.shoulder_match = static_cast<float>(shoulder_match);
+    const double blend = 1.0 / (shoulder_match - toe_match);
+    const bool reversed = shoulder_match < toe_match;
+    p.blend_scale = static_cast<float>(reversed ? -blend : blend);
+    p.blend_bias = static_cast<float>(reversed ? 1.0 + toe_match * blend : -toe_match * blend);
+    return p;
+}
+
+// Scratch rows in planar layout (R plane, G plane, B plane) so every stage is a flat loop the compiler can vectorize;
+// branches are written as selects for the same reason. params goes by value: a local copy cannot alias the rows, so
+// the loops need no runtime overlap checks.
+struct scratch {
+    std::vector<float> working, toned;
+};
+
+static void shade_row(const params p, const float *in, float *out, int width, int y, scratch &s) {
+    float *const r = s.working.data(), *const g = r + width, *const b = g + width;
+    const float vy = y * p.sy + p.by;
+
+    // exposure, vignette, white balance and the move to AP1
+    const auto &m = p.to_working;
+    for (int x = 0; x < width; ++x) {
+        const float vx = x * p.sx + p.bx;
+        const float falloff = 1.f / (1.f + vx * vx + vy * vy);
+        const float k = p.exposure * falloff * falloff;
+        const float ri = in[x * 3] * k, gi = in[x * 3 + 1] * k, bi = in[x * 3 + 2] * k;
+        const float ro = std::max(m[0] * ri + m[1] * gi + m[2] * bi, 0.f);
+        const float go = std::max(m[3] * ri + m[4] * gi + m[5] * bi, 0.f);
+        const float bo = std::max(m[6] * ri + m[7] * gi + m[8] * bi, 0.f);
+        // pre-desaturation
+        const float luma = kAp1Luma[0] * ro + kAp1Luma[1] * go + kAp1Luma[2] * bo;
+        r[x] = luma + (ro - luma) * 0.96f;
+        g[x] = luma + (go - luma) * 0.96f;
+        b[x] = luma + (bo - luma) * 0.96f;
+    }
+
+    // the curve is per channel, so all three planes go through one loop
+    const float *const work = s.working.data();
+    float *const tone = s.toned.data();
+    constexpr float kInvLn10 = 0.43429448190325176f;
+    const float toe_k = -2.f * p.slope / p.toe_scale, shoulder_k = 2.f * p.slope / p.shoulder_scale;
+    for (int i = 0; i < width * 3; ++i) {
+        const float l = std::log(std::fmax(work[i], 1e-10f)) * kInvLn10;
+        const float straight = p.slope * (l + p.straight_match);
+        float toe = -p.black_clip + 2.f * p.toe_scale / (1.f + std::exp(toe_k * (l - p.toe_match)));
+        float shoulder =
+            1.f + p.white_clip - 2.f * p.shoulder_scale / (1.f + std::exp(shoulder_k * (l - p.shoulder_match)));
+        toe = l < p.toe_match ? toe : straight;
+        shoulder = l > p.shoulder_match ? shoulder : straight;
+        float t = std::fmin(std::fmax(l * p.blend_scale + p.blend_bias, 0.f), 1.f);
+        t = (3.f - 2.f * t) * t * t;
+        tone[i] = toe + (shoulder - toe) * t;
+    }
+
+    // post-desaturation, ToneCurveAmount, back to sRGB and encode
+    const float *const tr = tone, *const tg = tr + width, *const tb = tg + width;
+    const auto &o = p.to_output;
+    const auto encode = [](float v) {
+        v = std::clamp(v, 0.f, 1.f);
+        return v <= 0.0031308f ? v * 12.92f : 1.055f * std::pow(v, 1.f / 2.4f) - 0.055f;
+    };
+    for (int x = 0; x < width; ++x) {
+        const float luma = kAp1Luma[0] * tr[x] + kAp1Luma[1] * tg[x] + kAp1Luma[2] * tb[x];
+        const float ro = std::max(luma + (tr[x] - luma) * 0.93f, 0.f);
+        const float go = std::max(luma + (tg[x] - luma) * 0.93f, 0.f);
+        const float bo = std::max(luma + (tb[x] - luma) * 0.93f, 0.f);
+        const float rf = r[x] + (ro - r[x]) * p.tone_amount;
+        const float gf = g[x] + (go - g[x]) * p.tone_amount;
+        const float bf = b[x] + (bo - b[x]) * p.tone_amount;
+        out[x * 3] = encode(o[0] * rf + o[1] * gf + o[2] * bf);
+        out[x * 3 + 1] = encode(o[3] * rf + o[4] * gf + o[5] * bf);
+        out[x * 3 + 2] = encode(o[6] * rf + o[7] * gf + o[8] * bf);
+    }
+}
+
+// =========================
+// Tiles
+// =========================
+// No stage looks at neighbouring pixels, so a tile is a band of whole rows: contiguous in memory, and one row of
+// scratch per worker stays in cache.
+static constexpr int kTileRows = 16;
+
+image render(const image &src, const preview_settings &settings, unsigned threads) {
+    image dst{src.width, src.height, std::vector<float>(src.pixels.size())};
+    if (src.width <= 0 || src.height <= 0)
+        return dst;
+
+    const params p = prepare(settings, src.width, src.height);
+    const std::size_t row = static_cast<std::size_t>(src.width) * 3;
+    const int tiles = (src.height + kTileRows - 1) / kTileRows;
+    std::atomic<int> next{0};
+
+    const auto worker = [&] {
+        scratch s{std::vector<float>(row), std::vector<float>(row)};
+        for (int tile; (tile = next.fetch_add(1, std::memory_order_relaxed)) < tiles;) {
+            const int end = std::min((tile + 1) * kTileRows, src.height);
+            for (int y = tile * kTileRows; y < end; ++y)
+                shade_row(p, src.pixels.data() + y * row, dst.pixels.data() + y * row, src.width, y, s);
+        }
+    };
+
+    threads = std::clamp(threads, 1u, static_cast<unsigned>(tiles));
+    std::vector<std::jthread> pool;
+    for (unsigned i = 1; i < threads; ++i)
+        pool.emplace_back(worker);
+    worker();
+    return dst;
+}
@@ -0,0 +1,126 @@
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <numbers>
+#include <span>
+#include <string>
+
+#include <imgui.h>
+#include <reshade.hpp>
+
+#include <easylogging++.h>
+
+#include <SDK/Engine_parameters.hpp>
+
+#include "addon.h"
+#include "view.h"
+
+// =========================
+// State (render thread)
+// =========================
+static view_override gView;
+
+void fill_view(override_snapshot &snapshot) { snapshot.view = gView; }
+
+// =========================
+// Camera update (game thread)
+// =========================
+void apply_view(const view_override &view, SDK::Params::CameraModifier_BlueprintModifyCamera &params) {
+    // from the inputs, so the result never depends on what the engine left in the outputs
+    params.NewViewLocation = params.ViewLocation;
+    params.NewViewRotation = params.ViewRotation;
+    params.NewFOV = view.fov > 0.f ? view.fov : params.fov;
+
+    if (view.offset[0] != 0.f || view.offset[1] != 0.f || view.offset[2] != 0.f) {
+        // view axes of the input rotation, as FRotationMatrix builds them (X forward, Y right, Z up)
+        constexpr auto kRad = std::numbers::pi / 180.0;
+        const auto sp = std::sin(params.ViewRotation.Pitch * kRad), cp = std::cos(params.ViewRotation.Pitch * kRad);
+        const auto sy = std::sin(params.ViewRotation.Yaw * kRad), cy = std::cos(params.ViewRotation.Yaw * kRad);
+        const auto sr = std::sin(params.ViewRotation.Roll * kRad), cr = std::cos(params.ViewRotation.Roll * kRad);
+        const std::array forward = {cp * cy, cp * sy, sp};
+        const std::array right = {sr * sp * cy - cr * sy, sr * sp * sy + cr * cy, -sr * cp};
+        const std::array up = {-(cr * sp * cy + sr * sy), cy * sr - cr * sp * sy, cr * cp};
+        auto along = [&](int a) {
+            return forward[a] * view.offset[0] + right[a] * view.offset[1] + up[a] * view.offset[2];
+        };
+        params.NewViewLocation.X += along(0);
+        params.NewViewLocation.Y += along(1);
+        params.NewViewLocation.Z += along(2);
+    }
+    params.NewViewRotation.Pitch += view.rotation[0];
+    params.NewViewRotation.Yaw += view.rotation[1];
+    params.NewViewRotation.Roll += view.rotation[2];
+}
+
+// =========================
+// Preset storage: View.Enabled, View.FOV, View.Offset=f,r,u, View.Rotation=p,y,r
+// =========================
+static std::string pack(std::span<const float> values) {
+    std::string out;
+    for (const auto v : values) {
+        char buf[32]{};
+        auto end = std::to_chars(std::begin(buf), std::end(buf), v).ptr;
+        out += (out.empty() ? "" : ",") + std::string(buf, end);
+    }
+    return out;
+}
+
+static void unpack(const char *s, std::size_t n, std::span<float> out) {
+    const auto end = s + n;
+    for (auto &v : out) {
+        auto res = std::from_chars(s, end, v);
+        if (res.ec != std::errc() || res.ptr == end)
+            return;
+        s = res.ptr + 1; // skip ','
+    }
+}
+
+static void save_view(reshade::api::effect_runtime *runtime) {
+    reshade::set_config_value(runtime, kSection, "View.Enabled", gView.enabled ? "1" : "0");
+    reshade::set_config_value(runtime, kSection, "View.FOV", pack({&gView.fov, 1}).c_str());
+    reshade::set_config_value(runtime, kSection, "View.Offset", pack(gView.offset).c_str());
+    reshade::set_config_value(runtime, kSection, "View.Rotation", pack(gView.rotation).c_str());
+}
+
+void load_view(reshade::api::effect_runtime *runtime) {
+    gView = {};
+    char buf[128]{};
+    std::size_t size = sizeof(buf);
+    gView.enabled =
+        reshade::get_config_value(runtime, kSection, "View.Enabled", buf, &size) && size > 0 && buf[0] == '1';
+    if (size = sizeof(buf); reshade::get_config_value(runtime, kSection, "View.FOV", buf, &size) && size > 1)
+        unpack(buf, size - 1, {&gView.fov, 1});
+    if (size = sizeof(buf); reshade::get_config_value(runtime, kSection, "View.Offset", buf, &size) && size > 1)
+        unpack(buf, size - 1, gView.offset);
+    if (size = sizeof(buf); reshade::get_config_value(runtime, kSection, "View.Rotation", buf, &size) && size > 1)
+        unpack(buf, size - 1, gView.rotation);
+}
+
+// =========================
+// Overlay panel
+// =========================
+void draw_view(reshade::api::effect_runtime *runtime) {
+    bool changed = ImGui::Checkbox("Enabled##view", &gView.enabled);
+    bool keep_fov = gView.fov <= 0.f;
+    if (ImGui::Checkbox("Keep game FOV", &keep_fov)) {
+        gView.fov = keep_fov ? 0.f : 90.f;
+        changed = true;
+    }
+    if (!keep_fov) {
+        ImGui::SliderFloat("FOV", &gView.fov, 20.f, 170.f, "%.1f deg");
+        changed |= ImGui::IsItemDeactivatedAfterEdit();
+    }
+    ImGui::InputFloat3("Offset (fwd, right, up)", gView.offset.data(), "%.1f");
+    changed |= ImGui::IsItemDeactivatedAfterEdit();
+    ImGui::SliderFloat3("Rotation (pitch, yaw, roll)", gView.rotation.data(), -180.f, 180.f, "%.1f");
+    changed |= ImGui::IsItemDeactivatedAfterEdit();
+    if (ImGui::Button("Reset")) {
+        gView = {.enabled = gView.enabled};
+        changed = true;
+    }
+    if (changed) {
+        save_view(runtime);
+        publish_overrides();
+        LOG(INFO) << "View override " << (gView.enabled ? "enabled" : "disabled") << ", FOV " << gView.fov;
+    }
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+namespace reshade::api {
+struct effect_runtime;
+}
+
+namespace SDK::Params {
+struct CameraModifier_BlueprintModifyCamera;
+}
+
+struct override_snapshot;
+struct view_override;
+
+// View-parameter overrides (FOV, view-space location and rotation offsets) applied through our camera modifier's
+// BlueprintModifyCamera. They travel in the same snapshot as the post-process overrides, and the camera update pins
+// that snapshot for both calls, so a view change and a post-process change can never be seen half applied.
+
+void load_view(reshade::api::effect_runtime *runtime);
+// copies the view override into a snapshot about to be published (render thread)
+void fill_view(override_snapshot &snapshot);
+// rewrites the modifier's output view from its input view (game thread)
+void apply_view(const view_override &view, SDK::Params::CameraModifier_BlueprintModifyCamera &params);
+
+void draw_view(reshade::api::effect_runtime *runtime);
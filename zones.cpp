@@ -0,0 +1,623 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+#include <windows.h>
+
+#include <imgui.h>
+#include <reshade.hpp>
+
+#include <easylogging++.h>
+
+#include <SDK/Engine_structs.hpp>
+
+#include "addon.h"
+#include "zones.h"
+
+// =========================
+// File format: header, nodes, zones, params; little-endian, 4-byte aligned, used in place from the mapping
+// =========================
+static constexpr uint32_t kZoneMagic = 0x4e5a5455; // "UTZN"
+static constexpr uint32_t kZoneVersion = 1;
+static constexpr uint32_t kLeafSize = 4;
+static constexpr std::size_t kMaxDepth = 64;
+
+struct zone_header {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t node_count;
+    uint32_t zone_count;
+    uint32_t param_count;
+};
+
+// count 0: interior node whose children are at index + 1 and first; otherwise zones [first, first + count)
+struct zone_node {
+    float min[3];
+    float max[3];
+    uint32_t first;
+    uint32_t count;
+};
+
+enum zone_shape : uint32_t { kBox = 0, kSphere = 1 };
+
+struct zone_record {
+    char name[32];
+    float center[3];
+    float extent[3]; // box half-size; a sphere's radius is extent[0]
+    float blend;     // distance outside the shape over which the weight falls from 1 to 0
+    uint32_t shape;
+    uint32_t first_param;
+    uint32_t param_count;
+};
+
+// keyed by item name rather than schema index, so a file outlives schema changes
+struct zone_param {
+    char key[44];
+    float value;
+};
+
+static_assert(sizeof(zone_header) == 20 && sizeof(zone_node) == 32 && sizeof(zone_record) == 72 &&
+              sizeof(zone_param) == 48);
+
+struct zone_map {
+    std::vector<std::byte> owned; // built in memory and not on disk yet
+    const void *view = nullptr;   // or mapped from the file
+    std::span<const zone_node> nodes;
+    std::span<const zone_record> zones;
+    std::span<const zone_param> params;
+    std::vector<uint16_t> items; // params resolved against the schema, kItemCount when unknown
+
+    zone_map() = default;
+    zone_map(const zone_map &) = delete;
+    zone_map &operator=(const zone_map &) = delete;
+    ~zone_map() {
+        if (view)
+            UnmapViewOfFile(view);
+    }
+
+    bool parse(const std::byte *data, std::size_t size) {
+        zone_header header{};
+        if (size < sizeof(header))
+            return false;
+        std::memcpy(&header, data, sizeof(header));
+        const auto need = sizeof(header) + std::size_t{header.node_count} * sizeof(zone_node) +
+                          std::size_t{header.zone_count} * sizeof(zone_record) +
+                          std::size_t{header.param_count} * sizeof(zone_param);
+        if (header.magic != kZoneMagic || header.version != kZoneVersion || size < need)
+            return false;
+        auto at = data + sizeof(header);
+        nodes = {reinterpret_cast<const zone_node *>(at), header.node_count};
+        at += nodes.size_bytes();
+        zones = {reinterpret_cast<const zone_record *>(at), header.zone_count};
+        at += zones.size_bytes();
+        params = {reinterpret_cast<const zone_param *>(at), header.param_count};
+
+        // a corrupt file must not send the query out of bounds
+        for (std::size_t i = 0; i < nodes.size(); ++i) {
+            const auto &node = nodes[i];
+            if (node.count ? node.first + std::size_t{node.count} > zones.size()
+                           : node.first <= i || node.first >= nodes.size() || i + 1 >= nodes.size())
+                return false;
+        }
+        for (const auto &zone : zones)
+            if (zone.first_param + std::size_t{zone.param_count} > params.size())
+                return false;
+        items.resize(params.size());
+        for (std::size_t i = 0; i < params.size(); ++i)
+            items[i] = static_cast<uint16_t>(find_item({params[i].key, strnlen(params[i].key, sizeof(params[i].key))}));
+        return true;
+    }
+};
+
+static std::shared_ptr<zone_map> map_file(const std::filesystem::path &path) {
+    auto file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return nullptr;
+    LARGE_INTEGER size{};
+    GetFileSizeEx(file, &size);
+    auto mapping = size.QuadPart > 0 ? CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+    CloseHandle(file);
+    if (!mapping)
+        return nullptr;
+    auto view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping); // the view keeps the section alive
+    if (!view)
+        return nullptr;
+    auto map = std::make_shared<zone_map>();
+    map->view = view;
+    if (!map->parse(static_cast<const std::byte *>(view), static_cast<std::size_t>(size.QuadPart))) {
+        LOG(ERROR) << "Zone file " << path.string() << " is not a valid version " << kZoneVersion << " file";
+        return nullptr;
+    }
+    return map;
+}
+
+// =========================
+// Editing and building (render thread)
+// =========================
+struct zone_edit {
+    std::array<char, 32> name{};
+    uint32_t shape = kBox;
+    std::array<float, 3> center{};
+    std::array<float, 3> extent{500.f, 500.f, 500.f};
+    float blend = 500.f;
+    std::vector<std::pair<std::size_t, float>> params; // schema index, value
+};
+
+static std::vector<zone_edit> gZones;
+static std::shared_ptr<const zone_map> gMap; // what the game thread gets
+static std::filesystem::path gPath;
+static bool gUnsaved = false;
+
+// a save is written next to the file and swapped in once no snapshot references the old mapping any more
+static std::filesystem::path gPendingSwap;
+static std::weak_ptr<const zone_map> gRetired;
+
+static std::array<float, 3> half_size(const zone_edit &zone) {
+    const auto r = zone.shape == kSphere ? zone.extent[0] : 0.f;
+    return zone.shape == kSphere ? std::array{r, r, r} : zone.extent;
+}
+
+struct build_item {
+    std::array<float, 3> lo, hi, centroid;
+    uint32_t zone;
+};
+
+// median split on the longest centroid axis; nodes come out depth-first with the left child right after its parent
+static void build(std::vector<build_item> &items, uint32_t first, uint32_t count, std::vector<zone_node> &nodes) {
+    zone_node node{};
+    std::array<float, 3> clo, chi;
+    for (int a = 0; a < 3; ++a) {
+        node.min[a] = clo[a] = std::numeric_limits<float>::max();
+        node.max[a] = chi[a] = std::numeric_limits<float>::lowest();
+    }
+    for (auto i = first; i < first + count; ++i) {
+        for (int a = 0; a < 3; ++a) {
+            node.min[a] = std::min(node.min[a], items[i].lo[a]);
+            node.max[a] = std::max(node.max[a], items[i].hi[a]);
+            clo[a] = std::min(clo[a], items[i].centroid[a]);
+            chi[a] = std::max(chi[a], items[i].centroid[a]);
+        }
+    }
+    const auto index = nodes.size();
+    nodes.push_back(node);
+    if (count <= kLeafSize) {
+        nodes[index].first = first;
+        nodes[index].count = count;
+        return;
+    }
+    int axis = 0;
+    for (int a = 1; a < 3; ++a)
+        if (chi[a] - clo[a] > chi[axis] - clo[axis])
+            axis = a;
+    const auto mid = first + count / 2;
+    std::nth_element(items.begin() + first, items.begin() + mid, items.begin() + first + count,
+                     [axis](const build_item &l, const build_item &r) { return l.centroid[axis] < r.centroid[axis]; });
+    build(items, first, mid - first, nodes);
+    nodes[index].first = static_cast<uint32_t>(nodes.size());
+    nodes[index].count = 0;
+    build(items, mid, first + count - mid, nodes);
+}
+
+static std::vector<std::byte> build_image(const std::vector<zone_edit> &zones) {
+    std::vector<build_item> items(zones.size());
+    for (std::size_t z = 0; z < zones.size(); ++z) {
+        const auto size = half_size(zones[z]);
+        for (int a = 0; a < 3; ++a) {
+            items[z].lo[a] = zones[z].center[a] - size[a] - zones[z].blend;
+            items[z].hi[a] = zones[z].center[a] + size[a] + zones[z].blend;
+            items[z].centroid[a] = zones[z].center[a];
+        }
+        items[z].zone = static_cast<uint32_t>(z);
+    }
+    std::vector<zone_node> nodes;
+    if (!items.empty())
+        build(items, 0, static_cast<uint32_t>(items.size()), nodes);
+
+    std::vector<zone_record> records;
+    std::vector<zone_param> params;
+    for (const auto &item : items) {
+        const auto &zone = zones[item.zone];
+        zone_record record{};
+        std::memcpy(record.name, zone.name.data(), sizeof(record.name) - 1);
+        for (int a = 0; a < 3; ++a) {
+            record.center[a] = zone.center[a];
+            record.extent[a] = zone.extent[a];
+        }
+        record.blend = zone.blend;
+        record.shape = zone.shape;
+        record.first_param = static_cast<uint32_t>(params.size());
+        record.param_count = static_cast<uint32_t>(zone.params.size());
+        for (const auto &[idx, value] : zone.params) {
+            zone_param param{};
+            std::strncpy(param.key, kItems[idx].key, sizeof(param.key) - 1);
+            param.value = value;
+            params.push_back(param);
+        }
+        records.push_back(record);
+    }
+
+    const zone_header header{kZoneMagic, kZoneVersion, static_cast<uint32_t>(nodes.size()),
+                             static_cast<uint32_t>(records.size()), static_cast<uint32_t>(params.size())};
+    std::vector<std::byte> image(sizeof(header) + nodes.size() * sizeof(zone_node) +
+                                 records.size() * sizeof(zone_record) + params.size() * sizeof(zone_param));
+    auto at = image.data();
+    auto put = [&](const void *data, std::size_t size) {
+        if (size)
+            std::memcpy(at, data, size);
+        at += size;
+    };
+    put(&header, sizeof(header));
+    put(nodes.data(), nodes.size() * sizeof(zone_node));
+    put(records.data(), records.size() * sizeof(zone_record));
+    put(params.data(), params.size() * sizeof(zone_param));
+    return image;
+}
+
+static std::vector<zone_edit> decode(const zone_map &map) {
+    std::vector<zone_edit> zones;
+    zones.reserve(map.zones.size());
+    for (const auto &record : map.zones) {
+        zone_edit zone;
+        std::memcpy(zone.name.data(), record.name, sizeof(record.name));
+        zone.name.back() = '\0';
+        zone.shape = record.shape;
+        for (int a = 0; a < 3; ++a) {
+            zone.center[a] = record.center[a];
+            zone.extent[a] = record.extent[a];
+        }
+        zone.blend = record.blend;
+        for (auto p = record.first_param; p < record.first_param + record.param_count; ++p)
+            if (map.items[p] < kItemCount)
+                zone.params.emplace_back(map.items[p], map.params[p].value);
+        zones.push_back(std::move(zone));
+    }
+    return zones;
+}
+
+// live preview of an edit: the game thread switches to an in-memory build right away
+static void rebuild() {
+    auto map = std::make_shared<zone_map>();
+    map->owned = build_image(gZones);
+    map->parse(map->owned.data(), map->owned.size());
+    if (gMap && gMap->view)
+        gRetired = gMap;
+    gMap = std::move(map);
+    gUnsaved = true;
+    publish_overrides();
+}
+
+static void save_zones() {
+    if (!gMap)
+        return;
+    auto temp = gPath;
+    temp += ".tmp";
+    std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char *>(gMap->owned.data()), static_cast<std::streamsize>(gMap->owned.size()));
+    out.close();
+    if (!out) {
+        LOG(ERROR) << "Failed to write " << temp.string();
+        return;
+    }
+    gPendingSwap = temp;
+    gUnsaved = false;
+}
+
+void step_zones() {
+    if (gPendingSwap.empty())
+        return;
+    if (!gRetired.expired()) {
+        // republishing cycles the triple buffer until nothing holds the old view
+        publish_overrides();
+        return;
+    }
+    if (!MoveFileExW(gPendingSwap.c_str(), gPath.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+        LOG(ERROR) << "Failed to replace " << gPath.string() << " (error " << GetLastError() << ")";
+        gPendingSwap.clear();
+        return;
+    }
+    gPendingSwap.clear();
+    if (auto mapped = map_file(gPath)) {
+        gMap = std::move(mapped);
+        publish_overrides();
+    }
+    LOG(INFO) << "Saved " << gZones.size() << " zones to " << gPath.string();
+}
+
+void load_zones(reshade::api::effect_runtime *runtime) {
+    char name[260]{};
+    std::size_t size = sizeof(name);
+    if (!reshade::get_config_value(runtime, kSection, "Zones.File", name, &size) || size <= 1)
+        std::strcpy(name, "untitled-zones.bin");
+    const auto path = std::filesystem::current_path() / name;
+    if (path == gPath && !gPendingSwap.empty())
+        return; // our own save is still being swapped in
+    gPath = path;
+    if (gMap && gMap->view)
+        gRetired = gMap;
+    gMap = map_file(gPath);
+    gZones = gMap ? decode(*gMap) : std::vector<zone_edit>();
+    gUnsaved = false;
+    LOG(INFO) << "Loaded " << gZones.size() << " zones from " << gPath.string();
+}
+
+void fill_zones(override_snapshot &snapshot) { snapshot.zones = gMap; }
+
+// =========================
+// Query (game thread)
+// =========================
+static std::atomic<float> gCameraX = 0.f, gCameraY = 0.f, gCameraZ = 0.f; // for placing zones from the panel
+static std::atomic<int> gActiveZones = 0;
+static std::atomic<float> gQueryNs = 0.f; // moving average over camera updates
+static std::array<float, kItemCount> gWeighted{}, gWeights{}, gStrongest{};
+static std::vector<uint16_t> gTouched;
+
+static float weight_of(const zone_record &zone, const float (&p)[3]) {
+    float squared = 0.f;
+    if (zone.shape == kSphere) {
+        for (int a = 0; a < 3; ++a)
+            squared += (p[a] - zone.center[a]) * (p[a] - zone.center[a]);
+        const auto outside = std::sqrt(squared) - zone.extent[0];
+        squared = outside > 0.f ? outside * outside : 0.f;
+    } else {
+        for (int a = 0; a < 3; ++a) {
+            const auto d = std::fabs(p[a] - zone.center[a]) - zone.extent[a];
+            if (d > 0.f)
+                squared += d * d;
+        }
+    }
+    if (squared <= 0.f)
+        return 1.f;
+    if (squared >= zone.blend * zone.blend)
+        return 0.f;
+    return 1.f - std::sqrt(squared) / zone.blend;
+}
+
+static bool contains(const zone_node &node, const float (&p)[3]) {
+    return p[0] >= node.min[0] && p[0] <= node.max[0] && p[1] >= node.min[1] && p[1] <= node.max[1] &&
+           p[2] >= node.min[2] && p[2] <= node.max[2];
+}
+
+void evaluate_zones(const override_snapshot &snapshot, const SDK::FVector &camera,
+                    SDK::FPostProcessSettings &settings) {
+    const float p[3] = {static_cast<float>(camera.X), static_cast<float>(camera.Y), static_cast<float>(camera.Z)};
+    gCameraX.store(p[0], std::memory_order_relaxed);
+    gCameraY.store(p[1], std::memory_order_relaxed);
+    gCameraZ.store(p[2], std::memory_order_relaxed);
+    const auto *map = snapshot.zones.get();
+    if (!map || map->nodes.empty()) {
+        gActiveZones.store(0, std::memory_order_relaxed);
+        return;
+    }
+    const auto start = std::chrono::steady_clock::now();
+
+    int active = 0;
+    uint32_t stack[kMaxDepth];
+    std::size_t depth = 0;
+    stack[depth++] = 0;
+    while (depth > 0) {
+        const auto index = stack[--depth];
+        const auto &node = map->nodes[index];
+        if (!contains(node, p))
+            continue;
+        if (node.count == 0) {
+            if (depth + 2 <= kMaxDepth) {
+                stack[depth++] = node.first;
+                stack[depth++] = index + 1;
+            }
+            continue;
+        }
+        for (auto z = node.first; z < node.first + node.count; ++z) {
+            const auto &zone = map->zones[z];
+            const auto weight = weight_of(zone, p);
+            if (weight <= 0.f)
+                continue;
+            ++active;
+            for (auto i = zone.first_param; i < zone.first_param + zone.param_count; ++i) {
+                const auto item = map->items[i];
+                if (item >= kItemCount)
+                    continue;
+                if (gWeights[item] == 0.f)
+                    gTouched.push_back(item);
+                gWeighted[item] += weight * map->params[i].value;
+                gWeights[item] += weight;
+                gStrongest[item] = std::max(gStrongest[item], weight);
+            }
+        }
+    }
+
+    // overlapping zones average by weight; the strongest one decides how far the value moves off the base override.
+    // Items with no base override have nothing to fade from and take the zone value as soon as the camera is inside
+    // the blend radius.
+    for (const auto item : gTouched) {
+        auto value = gWeighted[item] / gWeights[item];
+        if (float base = 0.f; get_item(settings, item, base))
+            value = std::lerp(base, value, gStrongest[item]);
+        if (kItems[item].is_int)
+            value = std::round(value);
+        set_item(settings, item, true, value);
+        gWeighted[item] = gWeights[item] = gStrongest[item] = 0.f;
+    }
+    gTouched.clear();
+
+    const auto ns = std::chrono::duration<float, std::nano>(std::chrono::steady_clock::now() - start).count();
+    gActiveZones.store(active, std::memory_order_relaxed);
+    gQueryNs.store(gQueryNs.load(std::memory_order_relaxed) * 0.95f + ns * 0.05f, std::memory_order_relaxed);
+}
+
+float zone_weight(std::string_view name) {
+    if (!gMap)
+        return 0.f;
+    const float p[3] = {gCameraX.load(std::memory_order_relaxed), gCameraY.load(std::memory_order_relaxed),
+                        gCameraZ.load(std::memory_order_relaxed)};
+    float weight = 0.f;
+    for (const auto &zone : gMap->zones)
+        if (std::string_view(zone.name, strnlen(zone.name, sizeof(zone.name))) == name)
+            weight = std::max(weight, weight_of(zone, p));
+    return weight;
+}
+
+// =========================
+// Overlay panel
+// =========================
+static std::size_t gSelected = std::numeric_limits<std::size_t>::max();
+
+static void add_zone(uint32_t shape) {
+    zone_edit zone;
+    std::snprintf(zone.name.data(), zone.name.size(), "Zone %zu", gZones.size() + 1);
+    zone.shape = shape;
+    zone.center = {gCameraX.load(std::memory_order_relaxed), gCameraY.load(std::memory_order_relaxed),
+                   gCameraZ.load(std::memory_order_relaxed)};
+    gZones.push_back(std::move(zone));
+    gSelected = gZones.size() - 1;
+}
+
+static bool draw_zone(zone_edit &zone) {
+    bool changed = false;
+    ImGui::InputText("Name", zone.name.data(), zone.name.size());
+    changed |= ImGui::IsItemDeactivatedAfterEdit();
+    int shape = static_cast<int>(zone.shape);
+    if (ImGui::Combo("Shape", &shape, "Box\0Sphere\0")) {
+        zone.shape = static_cast<uint32_t>(shape);
+        changed = true;
+    }
+    ImGui::InputFloat3("Center", zone.center.data(), "%.0f");
+    changed |= ImGui::IsItemDeactivatedAfterEdit();
+    ImGui::SameLine();
+    if (ImGui::SmallButton("Here")) {
+        zone.center = {gCameraX.load(std::memory_order_relaxed), gCameraY.load(std::memory_order_relaxed),
+                       gCameraZ.load(std::memory_order_relaxed)};
+        changed = true;
+    }
+    if (zone.shape == kSphere)
+        ImGui::InputFloat("Radius", &zone.extent[0], 100.f, 1000.f, "%.0f");
+    else
+        ImGui::InputFloat3("Half size", zone.extent.data(), "%.0f");
+    changed |= ImGui::IsItemDeactivatedAfterEdit();
+    ImGui::InputFloat("Blend", &zone.blend, 100.f, 1000.f, "%.0f");
+    changed |= ImGui::IsItemDeactivatedAfterEdit();
+    for (auto &e : zone.extent)
+        e = std::max(e, 0.f);
+    zone.blend = std::max(zone.blend, 0.f);
+
+    std::size_t remove = zone.params.size();
+    for (std::size_t i = 0; i < zone.params.size(); ++i) {
+        auto &[item, value] = zone.params[i];
+        const auto &desc = kItems[item];
+        ImGui::PushID(static_cast<int>(i));
+        if (desc.ranged)
+            ImGui::SliderFloat(desc.key, &value, desc.min, desc.max, desc.is_int ? "%.0f" : "%.3f");
+        else
+            ImGui::InputFloat(desc.key, &value);
+        changed |= ImGui::IsItemDeactivatedAfterEdit();
+        ImGui::SameLine();
+        if (ImGui::SmallButton("x"))
+            remove = i;
+        ImGui::PopID();
+    }
+    if (remove < zone.params.size()) {
+        zone.params.erase(zone.params.begin() + static_cast<std::ptrdiff_t>(remove));
+        changed = true;
+    }
+    static int pick = 0;
+    if (ImGui::BeginCombo("##param", kItems[static_cast<std::size_t>(pick)].key)) {
+        for (std::size_t i = 0; i < kItemCount; ++i)
+            if (ImGui::Selectable(kItems[i].key, static_cast<int>(i) == pick))
+                pick = static_cast<int>(i);
+        ImGui::EndCombo();
+    }
+    ImGui::SameLine();
+    const auto item = static_cast<std::size_t>(pick);
+    const bool exists = std::ranges::any_of(zone.params, [&](const auto &param) { return param.first == item; });
+    ImGui::BeginDisabled(exists);
+    if (ImGui::Button("Add value")) {
+        auto &value = gValues[item];
+        zone.params.emplace_back(item, kItems[item].is_int ? static_cast<float>(value.get<int>()) : value.get<float>());
+        changed = true;
+    }
+    ImGui::EndDisabled();
+    return changed;
+}
+
+void draw_zones(reshade::api::effect_runtime *runtime) {
+    ImGui::TextDisabled("%s", gPath.string().c_str());
+    ImGui::TextDisabled("Camera %.0f %.0f %.0f, %d of %zu zones active, query %.0f ns",
+                        gCameraX.load(std::memory_order_relaxed), gCameraY.load(std::memory_order_relaxed),
+                        gCameraZ.load(std::memory_order_relaxed), gActiveZones.load(std::memory_order_relaxed),
+                        gZones.size(), gQueryNs.load(std::memory_order_relaxed));
+
+    bool changed = false;
+    if (ImGui::Button("Add box here")) {
+        add_zone(kBox);
+        changed = true;
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Add sphere here")) {
+        add_zone(kSphere);
+        changed = true;
+    }
+    ImGui::SameLine();
+    ImGui::BeginDisabled(!gUnsaved || !gPendingSwap.empty());
+    if (ImGui::Button("Save"))
+        save_zones();
+    ImGui::EndDisabled();
+    ImGui::SameLine();
+    if (ImGui::Button("Reload")) {
+        load_zones(runtime);
+        publish_overrides();
+    }
+
+    constexpr auto flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY;
+    if (!gZones.empty() && ImGui::BeginTable("##zones", 3, flags, ImVec2(0, 200))) {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("Zone");
+        ImGui::TableSetupColumn("Center");
+        ImGui::TableSetupColumn("Values");
+        ImGui::TableHeadersRow();
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(gZones.size()));
+        while (clipper.Step()) {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+                const auto &zone = gZones[static_cast<std::size_t>(row)];
+                ImGui::PushID(row);
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                if (ImGui::Selectable(zone.name.data(), gSelected == static_cast<std::size_t>(row),
+                                      ImGuiSelectableFlags_SpanAllColumns))
+                    gSelected = static_cast<std::size_t>(row);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.0f %.0f %.0f", zone.center[0], zone.center[1], zone.center[2]);
+                ImGui::TableNextColumn();
+                ImGui::Text("%zu", zone.params.size());
+                ImGui::PopID();
+            }
+        }
+        ImGui::EndTable();
+    }
+
+    if (gSelected < gZones.size()) {
+        ImGui::Separator();
+        ImGui::PushID("zone");
+        changed |= draw_zone(gZones[gSelected]);
+        if (ImGui::Button("Delete zone")) {
+            gZones.erase(gZones.begin() + static_cast<std::ptrdiff_t>(gSelected));
+            gSelected = std::numeric_limits<std::size_t>::max();
+            changed = true;
+        }
+        ImGui::PopID();
+    }
+
+    if (changed)
+        rebuild();
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <string_view>
+
+namespace reshade::api {
+struct effect_runtime;
+}
+
+namespace SDK {
+struct FPostProcessSettings;
+struct FVector;
+} // namespace SDK
+
+struct override_snapshot;
+
+// Spatial override zones: boxes and spheres with a blend radius, each carrying a few item values. Stored in a flat
+// binary file ([untitled] Zones.File, next to the game executable) that is memory-mapped and queried in place: a
+// bounding-volume hierarchy over the zones keeps each camera update's lookup logarithmic in the zone count.
+
+void load_zones(reshade::api::effect_runtime *runtime);
+// hands the current zone map to a snapshot about to be published (render thread)
+void fill_zones(override_snapshot &snapshot);
+// finishes a pending save once the game thread has let go of the old mapping; called from reshade_present
+void step_zones();
+// blends every zone around the camera into settings, on top of the global and curve values (game thread)
+void evaluate_zones(const override_snapshot &snapshot, const SDK::FVector &camera,
+                    SDK::FPostProcessSettings &settings);
+// strongest weight of the zones with this name at the last camera position (render thread)
+float zone_weight(std::string_view name);
+
+void draw_zones(reshade::api::effect_runtime *runtime);